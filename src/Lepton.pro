@@ -14,6 +14,9 @@ equals(QMAKE_CXX, "g++") {
 }
 DEFINES     += "CXX11_REGEX"
 
+# uncomment to remove lexer profiling (see lexerprofiler.h) from the lexer entirely
+#DEFINES    += LEPTON_NO_LEXER_PROFILING
+
 CONFIG      += qscintilla2
 
 SOURCES += main.cpp\
@@ -31,7 +34,21 @@ SOURCES += main.cpp\
     loadprojectasdialog.cpp \
     projectlistmodel.cpp \
     projectlistitem.cpp \
-    sessionmanager.cpp
+    sessionmanager.cpp \
+    grammarregistry.cpp \
+    lexerprofiler.cpp \
+    lexerprofilerpanel.cpp \
+    fileloader.cpp \
+    savejob.cpp \
+    textencoding.cpp \
+    savetransforms.cpp \
+    linediff.cpp \
+    editjournal.cpp \
+    prefetchjob.cpp \
+    mappedfile.cpp \
+    hexviewer.cpp \
+    lineindexer.cpp \
+    largefileviewer.cpp
 
 HEADERS  += mainwindow.h \
     editortabbar.h \
@@ -48,7 +65,21 @@ HEADERS  += mainwindow.h \
     loadprojectasdialog.h \
     projectlistmodel.h \
     projectlistitem.h \
-    sessionmanager.h
+    sessionmanager.h \
+    grammarregistry.h \
+    lexerprofiler.h \
+    lexerprofilerpanel.h \
+    fileloader.h \
+    savejob.h \
+    textencoding.h \
+    savetransforms.h \
+    linediff.h \
+    editjournal.h \
+    prefetchjob.h \
+    mappedfile.h \
+    hexviewer.h \
+    lineindexer.h \
+    largefileviewer.h
 
 FORMS    += mainwindow.ui \
     settingseditor.ui \
@@ -57,3 +88,6 @@ FORMS    += mainwindow.ui \
     loadprojectasdialog.ui
 
 unix|win32: LIBS += -lqscintilla2
+
+# native matchers of the bundled language files
+include(builtinlanguages.pri)
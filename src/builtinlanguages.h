@@ -0,0 +1,81 @@
+/*
+Project: Lepton Editor
+File: builtinlanguages.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file declares the native matchers of the language files bundled with Lepton.  The
+    matchers are state machines generated at build time by `tools/genlexers.py` (see
+    builtinlanguages.pri) from the regular expressions of the token rules.  When a language
+    file on disk is identical to the one Lepton was built with, its token rules use these
+    matchers instead of `QRegularExpression`.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BUILTINLANGUAGES_H
+#define BUILTINLANGUAGES_H
+
+// Qt classes
+#include <QChar>
+#include <QByteArray>
+
+
+
+const int NativeNoMatch = -1;       //returned by a native matcher when its pattern does not match the text
+const int NativePartialMatch = -2;  //returned by a native matcher when its pattern partially matches the text
+
+/*
+A native matcher: matches a pattern against the start of `text` (`length` characters of valid UTF-16)
+and returns the length of the text matched, `NativeNoMatch` or, only if `partial` is true,
+`NativePartialMatch`.  The results are the same as `QRegularExpression::match()` for the pattern, with
+`PartialPreferFirstMatch` if `partial` is true and `NormalMatch` otherwise.
+*/
+typedef int (*NativeMatcher)(const QChar* text, int length, bool partial);
+
+/*
+The native matcher of a pattern used by the token rules of a built-in language.
+*/
+struct BuiltinMatcher {
+    const char* pattern;    // the pattern (in UTF-8), including the anchors added by `GrammarRegistry` (ex. "^(...)")
+    NativeMatcher match;    // the matcher generated for the pattern
+};
+
+/*
+A language file bundled with Lepton.  Only the patterns of the rules defined by the file itself
+(not those of the languages it uses or includes) have matchers, and only if the generator supports
+every construct they use.
+*/
+struct BuiltinLanguage {
+    const char* fileName;           // name of the language file
+    const char* sha1;               // hex SHA-1 hash of the language file the matchers were generated from
+    const BuiltinMatcher* matchers; // the native matchers of the file's patterns
+    int matcherCount;               // number of native matchers
+};
+
+const BuiltinLanguage* findBuiltinLanguage(const QByteArray& sha1Hex);
+/*  -returns the built-in language generated from a file with hash `sha1Hex` or 0 if there is none */
+
+#endif // BUILTINLANGUAGES_H
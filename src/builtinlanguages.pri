@@ -0,0 +1,23 @@
+# generates the native matchers of the language files bundled with Lepton (see builtinlanguages.h),
+# for every project which compiles the lexer
+isEmpty(PYTHON): PYTHON = python3
+
+BUILTIN_LANGUAGES = \
+    $$PWD/../config/languages/c.xml \
+    $$PWD/../config/languages/cplusplus.xml \
+    $$PWD/../config/languages/haskell.xml \
+    $$PWD/../config/languages/html_php.xml \
+    $$PWD/../config/languages/javascript.xml \
+    $$PWD/../config/languages/octave_matlab.xml \
+    $$PWD/../config/languages/python.xml \
+    $$PWD/../config/languages/xml.xml
+
+HEADERS += $$PWD/builtinlanguages.h
+
+genlexers.input         = BUILTIN_LANGUAGES
+genlexers.output        = builtinlanguages.cpp
+genlexers.commands      = $$PYTHON $$PWD/../tools/genlexers.py -o ${QMAKE_FILE_OUT} ${QMAKE_FILE_IN}
+genlexers.depends       = $$PWD/../tools/genlexers.py
+genlexers.variable_out  = SOURCES
+genlexers.CONFIG       += combine
+QMAKE_EXTRA_COMPILERS  += genlexers
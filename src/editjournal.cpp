@@ -0,0 +1,317 @@
+/*
+Project: Lepton Editor
+File: editjournal.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the EditJournal class.  It records the changes made
+    to a document which was not saved in a journal file, so that they can be recovered if the
+    editor crashes.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "editjournal.h"
+
+//include Qt classes
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QSaveFile>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include system headers
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+
+
+//~static data~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static const quint32 journalMagic = 0x4C504A31;    //"LPJ1"
+static const char insertRecord = 'I';
+static const char deleteRecord = 'D';
+static const char checkpointRecord = 'C';
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static QString instanceName() {
+/*  -returns the name of this instance's lock, which also starts the names of its journals */
+
+    //the start time keeps the name unique when the process id of an instance which crashed is reused
+    static const QString name = QString("%1-%2").arg(QCoreApplication::applicationPid()).arg(QDateTime::currentMSecsSinceEpoch());
+    return name;
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+EditJournal::EditJournal(QObject* parent) : QObject(parent), baseSize(0), recordedLength(0), headerLength(0) {
+/*  -Class constructor */
+
+    //every journal of this instance gets a name of its own, starting with the name of the instance (see `orphanedJournals()`)
+    static int journalCount = 0;
+    QString dirPath = journalsDirPath();
+    if ( !dirPath.isEmpty() ) journalPath = QDir(dirPath).filePath( QString("%1-%2.journal").arg(instanceName()).arg(journalCount++) );
+
+    syncTimer.setSingleShot(true);
+    syncTimer.setInterval( LeptonConfig::mainSettings->getValueOrDefault(1000, "journal", "sync_interval").toInt() );
+    connect(&syncTimer, SIGNAL(timeout()), this, SLOT(sync()));
+}
+
+EditJournal::~EditJournal() {
+/*  -Class destructor (the journal is removed, since the document is closed) */
+    removeJournal();
+}
+
+void EditJournal::setBase(const QString& filePath, const QDateTime& modified, qint64 size) {
+/*  -discards the changes recorded: the document is now the same as the file at `filePath` (empty if none) */
+    removeJournal();
+    baseFilePath = filePath;
+    baseModified = modified;
+    baseSize = size;
+}
+
+void EditJournal::recordInsert(int position, const char* text, int length) {
+/*  -records that `length` bytes of `text` were inserted at `position` */
+    appendRecord(insertRecord, position, length, text);
+}
+
+void EditJournal::recordDelete(int position, int length) {
+/*  -records that `length` bytes were removed at `position` */
+    appendRecord(deleteRecord, position, length, 0);
+}
+
+qint64 EditJournal::mark() {
+/*  -returns the amount of changes recorded so far (used with `discardUpTo()`) */
+    return recordedLength;
+}
+
+void EditJournal::discardUpTo(qint64 markedLength, const QString& filePath, const QDateTime& modified, qint64 size) {
+/*
+-discards the changes recorded before `mark()` returned `markedLength`: the document as it was then was saved to
+ the file at `filePath`, which becomes the new base
+*/
+    if (markedLength >= recordedLength) {
+        setBase(filePath, modified, size);
+        return;
+    }
+
+    //the changes made since the mark are kept, on top of the new base
+    sync();
+    QByteArray remaining;
+    if ( journalFile.isOpen() && journalFile.seek(headerLength + markedLength) ) remaining = journalFile.readAll();
+
+    setBase(filePath, modified, size);
+    pending = remaining;
+    recordedLength = remaining.size();
+    sync();
+}
+
+void EditJournal::checkpoint(const QString& filePath, const QDateTime& modified, qint64 size, const char* text, int length) {
+/*
+-discards the changes recorded and records `text`, the whole text of the document, instead: the file at
+ `filePath` becomes the new base, but the document is not the same as it (ex. its save transforms were not applied)
+*/
+    setBase(filePath, modified, size);
+    appendRecord(checkpointRecord, 0, length, text);
+    sync();
+}
+
+QList<EditJournal::Recovery> EditJournal::orphanedJournals() {
+/*  -returns (and removes) the journals left behind by instances of the editor which did not exit cleanly */
+    QList<Recovery> journals;
+    QString dirPath = journalsDirPath();
+    if ( dirPath.isEmpty() ) return journals;
+    QDir dir(dirPath);
+
+    foreach (const QFileInfo& entry, dir.entryInfoList(QStringList("*.journal"), QDir::Files)) {
+        //a journal belongs to an instance which is still running (this one included) if that instance still holds its lock
+        const QString owner = entry.fileName().section('-', 0, 1);
+        QLockFile ownerLock( dir.filePath(owner + ".lock") );
+        if (! ownerLock.tryLock(0) ) continue;
+        ownerLock.unlock();
+
+        QFile file( entry.absoluteFilePath() );
+        if (! file.open(QIODevice::ReadOnly) ) continue;
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic = 0;
+        Recovery recovery;
+        stream >> magic >> recovery.filePath >> recovery.baseModified >> recovery.baseSize;
+        if (stream.status() == QDataStream::Ok && magic == journalMagic) {
+            recovery.journalPath = entry.absoluteFilePath();
+            recovery.records = file.readAll();
+            journals.append(recovery);
+        }
+        file.close();
+        file.remove();
+    }
+    return journals;
+}
+
+bool EditJournal::replay(const QByteArray& records, QsciScintillaBase* editor) {
+/*
+-applies the changes in `records` to the document in `editor`
+-returns false if some changes could not be applied (ex. the end of the journal was not completely written)
+*/
+    QDataStream stream(records);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    while (! stream.atEnd() ) {
+        qint8 type = 0;
+        qint32 position = 0;
+        qint32 length = 0;
+        stream >> type >> position >> length;
+        if (stream.status() != QDataStream::Ok || length < 0) return false;
+
+        const int documentLength = editor->SendScintilla(QsciScintillaBase::SCI_GETLENGTH);
+        if (type == insertRecord) {
+            QByteArray text(length, '\0');
+            if ( stream.readRawData(text.data(), length) != length ) return false;     //the record was cut short by the crash
+            if (position < 0 || position > documentLength) return false;
+            editor->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, position);
+            editor->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, position);
+            editor->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET, length, text.constData());
+        }
+        else if (type == deleteRecord) {
+            if (position < 0 || position + length > documentLength) return false;
+            editor->SendScintilla(QsciScintillaBase::SCI_DELETERANGE, position, length);
+        }
+        else if (type == checkpointRecord) {
+            QByteArray text(length, '\0');
+            if ( stream.readRawData(text.data(), length) != length ) return false;
+            editor->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, 0);
+            editor->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, documentLength);
+            editor->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET, length, text.constData());
+        }
+        else return false;
+    }
+    return true;
+}
+
+
+
+//~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void EditJournal::sync() {
+/*  -writes the buffered changes to the journal and syncs it to disk */
+    syncTimer.stop();
+    if ( pending.isEmpty() || journalPath.isEmpty() ) return;
+
+    //the journal is only created once there is something to recover
+    if (! journalFile.isOpen() ) {
+        journalFile.setFileName(journalPath);
+        if (! journalFile.open(QIODevice::ReadWrite | QIODevice::Truncate) ) return;
+        QByteArray fileHeader = header();
+        headerLength = fileHeader.size();
+        journalFile.write(fileHeader);
+    }
+
+    journalFile.seek( journalFile.size() );
+    journalFile.write(pending);
+    journalFile.flush();
+#ifdef Q_OS_UNIX
+    ::fdatasync( journalFile.handle() );
+#endif
+    pending.clear();
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void EditJournal::appendRecord(char type, int position, int length, const char* text) {
+/*  -adds a record to the changes waiting to be written */
+
+    /*######################################################################################
+    ### Each record is the type of the change, its position and its length, followed by   ##
+    ### the text inserted (the text removed does not need to be known to replay it).      ##
+    ### Records are written and synced together after a short delay, or as soon as a lot ##
+    ### of text is waiting, so typing causes a small write every now and then instead of ##
+    ### one per keystroke.                                                                ##
+    ######################################################################################*/
+
+    if ( journalPath.isEmpty() ) return;
+
+    QDataStream stream(&pending, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setVersion(QDataStream::Qt_5_0);
+    const int previousSize = pending.size();
+    stream << qint8(type) << qint32(position) << qint32(length);
+    if (text != 0) stream.writeRawData(text, length);
+    recordedLength += pending.size() - previousSize;
+
+    if (pending.size() >= 1048576) sync();
+    else if (! syncTimer.isActive() ) syncTimer.start();
+}
+
+void EditJournal::removeJournal() {
+/*  -deletes the journal file and forgets the changes waiting to be written */
+    syncTimer.stop();
+    pending.clear();
+    recordedLength = 0;
+    if ( journalFile.isOpen() ) {
+        journalFile.close();
+        journalFile.remove();
+    }
+}
+
+QByteArray EditJournal::header() {
+/*  -returns the header of the journal file, which describes its base */
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << journalMagic << baseFilePath << baseModified << baseSize;
+    return data;
+}
+
+QString EditJournal::journalsDirPath() {
+/*  -returns the directory in which journals are written (empty if there is none), locking it for this instance */
+
+    //the lock of this instance tells other instances that its journals are still being written (see `orphanedJournals()`)
+    static QString dirPath;
+    static QLockFile* instanceLock = 0;
+    if (instanceLock == 0) {
+        QString sessionsDirPath = LeptonConfig::mainSettings->getConfigDirPath("sessions");
+        if ( !sessionsDirPath.isEmpty() && QDir(sessionsDirPath).mkpath("journals") ) {
+            dirPath = QDir(sessionsDirPath).filePath("journals");
+            instanceLock = new QLockFile( QDir(dirPath).filePath( instanceName() + ".lock" ) );
+            if (! instanceLock->tryLock(0) ) dirPath.clear();
+        }
+    }
+    return dirPath;
+}
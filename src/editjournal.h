@@ -0,0 +1,140 @@
+/*
+Project: Lepton Editor
+File: editjournal.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the EditJournal class.  It records the changes made
+    to a document which was not saved in a small file (a journal) in the sessions directory,
+    so that they can be recovered if the editor crashes.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EDITJOURNAL_H
+#define EDITJOURNAL_H
+
+//include Qt classes
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QTimer>
+#include <QList>
+
+//include QScintilla classes
+#include <Qsci/qsciscintillabase.h>
+
+
+
+class EditJournal : public QObject {
+/*
+-A class that appends the insertions and removals made to a document to a journal file.
+-The journal starts from a "base": the file the document was loaded from or saved to (or an empty document).
+ Replaying the journal on top of the base gives the document as it was when the journal was last synced.
+-Records are buffered and synced to disk in batches, so the disk is only written to in proportion to the typing.
+-When the document is not the same as its base, the journal starts with a checkpoint: a record of its whole text.
+*/
+
+    Q_OBJECT
+
+    public:
+        struct Recovery {
+                QString journalPath;        //path to the journal
+                QString filePath;           //path to the base file (empty if the base is an empty document)
+                QDateTime baseModified;     //last modification time of the base file when the journal was started
+                qint64 baseSize;            //size of the base file when the journal was started
+                QByteArray records;         //the changes recorded (see `replay()`)
+        };
+
+        explicit EditJournal(QObject* parent = 0);
+        /*  -Class constructor */
+
+        ~EditJournal();
+        /*  -Class destructor (the journal is removed, since the document is closed) */
+
+        void setBase(const QString& filePath, const QDateTime& modified, qint64 size);
+        /*  -discards the changes recorded: the document is now the same as the file at `filePath` (empty if none) */
+
+        void recordInsert(int position, const char* text, int length);
+        /*  -records that `length` bytes of `text` were inserted at `position` */
+
+        void recordDelete(int position, int length);
+        /*  -records that `length` bytes were removed at `position` */
+
+        qint64 mark();
+        /*  -returns the amount of changes recorded so far (used with `discardUpTo()`) */
+
+        void discardUpTo(qint64 markedLength, const QString& filePath, const QDateTime& modified, qint64 size);
+        /*
+            -discards the changes recorded before `mark()` returned `markedLength`: the document as it was then was saved to
+             the file at `filePath`, which becomes the new base
+        */
+
+        void checkpoint(const QString& filePath, const QDateTime& modified, qint64 size, const char* text, int length);
+        /*
+            -discards the changes recorded and records `text`, the whole text of the document, instead: the file at
+             `filePath` becomes the new base, but the document is not the same as it (ex. its save transforms were not applied)
+        */
+
+        static QList<Recovery> orphanedJournals();
+        /*  -returns (and removes) the journals left behind by instances of the editor which did not exit cleanly */
+
+        static bool replay(const QByteArray& records, QsciScintillaBase* editor);
+        /*
+            -applies the changes in `records` to the document in `editor`
+            -returns false if some changes could not be applied (ex. the end of the journal was not completely written)
+        */
+
+    public slots:
+        void sync();
+        /*  -writes the buffered changes to the journal and syncs it to disk */
+
+    private:
+        QString journalPath;        //path to the journal (empty if journals can not be written)
+        QFile journalFile;          //the journal, once it was created
+        QString baseFilePath;       //path to the base file (empty if the base is an empty document)
+        QDateTime baseModified;     //last modification time of the base file
+        qint64 baseSize;            //size of the base file
+        QByteArray pending;         //changes recorded but not written to the journal yet
+        qint64 recordedLength;      //length of the changes recorded since the base was set
+        qint64 headerLength;        //length of the header of the journal file
+        QTimer syncTimer;           //timer used to sync changes in batches
+
+        void appendRecord(char type, int position, int length, const char* text);
+        /*  -adds a record to the changes waiting to be written */
+
+        void removeJournal();
+        /*  -deletes the journal file and forgets the changes waiting to be written */
+
+        QByteArray header();
+        /*  -returns the header of the journal file, which describes its base */
+
+        static QString journalsDirPath();
+        /*  -returns the directory in which journals are written (empty if there is none), locking it for this instance */
+};
+
+#endif // EDITJOURNAL_H
@@ -71,14 +71,50 @@ int EditorTabBar::addTab(int index) {
     return i;   //return the index of the tab
 }
 
+int EditorTabBar::addViewer(QWidget* viewer, const QString& label, int index) {
+/*
+-adds a tab showing a read-only viewer (ex. of a binary file) and returns its index
+-the viewer must have a `filePath` property (see `filePathAt()`)
+-parameters:
+    index: the index at which to place the new tab (-1 if at the end)
+*/
+    int i = index < 0 ? QTabWidget::addTab(viewer, label) : QTabWidget::insertTab(index, viewer, label);
+    this->setCurrentIndex(i);
+    return i;
+}
+
+void EditorTabBar::replaceTab(int index, QWidget* viewer, const QString& label) {
+/*  -replaces the tab at `index` (which must not have unsaved changes) by a viewer, without changing the current tab */
+    QWidget* old = widget(index);
+    ScintillaEditor* editor = getEditor(index);
+    if (editor != 0) disconnect(editor, SIGNAL(modificationChanged(bool)), this, SLOT(setLabel(bool)) );
+
+    //the tab is swapped silently, so that the tabs next to it are not shown (and loaded) in the meantime
+    bool wasCurrent = index == currentIndex();
+    blockSignals(true);
+    removeTab(index);
+    QTabWidget::insertTab(index, viewer, label);
+    if (wasCurrent) setCurrentIndex(index);
+    blockSignals(false);
+
+    delete old;
+}
+
 ScintillaEditor* EditorTabBar::current(){
-/* -access current tab object */
-    return (ScintillaEditor*)(currentWidget());
+/* -access current tab object (null if the current tab is a viewer rather than an editor) */
+    return qobject_cast<ScintillaEditor*>( currentWidget() );
 }
 
 ScintillaEditor* EditorTabBar::getEditor(int i) {
-/* -access tab object using its index */
-    return (ScintillaEditor*)(widget(i));
+/* -access tab object using its index (null if the tab is a viewer rather than an editor) */
+    return qobject_cast<ScintillaEditor*>( widget(i) );
+}
+
+QString EditorTabBar::filePathAt(int i) {
+/*  -returns the path to the file shown in a tab, whether it is an editor or a viewer */
+    ScintillaEditor* editor = getEditor(i);
+    if (editor != 0) return editor->getOpenFilePath();
+    return widget(i) != 0 ? widget(i)->property("filePath").toString() : QString();
 }
 
 int EditorTabBar::closeAll() {
@@ -112,8 +148,16 @@ int EditorTabBar::closeEditor(const int& index){
     - '-1' if an unknown error has occured and the tab could not be closed
     - '0' if tab was closed succesfully
 */
-    //if the file being closed was not saved, create a message box to ask the user what to do
-    if( ! getEditor(index)->wasFileSaved() ) {
+    //viewers can not change their file, so they are simply closed
+    if ( getEditor(index) == 0 ) {
+        QWidget* viewer = widget(index);
+        this->removeTab(index);
+        delete viewer;
+        return 0;
+    }
+
+    //if the file being closed was not saved (and is not still shown in another tab), create a message box to ask the user what to do
+    if( ! getEditor(index)->wasFileSaved() && ! getEditor(index)->hasOtherViews() ) {
 
         //get the file name of the document being closed
         QString msg = tr("The following file was not saved: %1\nWhat would you like to do?").arg( tabText(index) );
@@ -62,11 +62,25 @@ class EditorTabBar : public QTabWidget
             index: the index at which to place the new tab (-1 if at the end)
         */
 
+        int addViewer(QWidget* viewer, const QString& label, int index = -1);
+        /*
+        -adds a tab showing a read-only viewer (ex. of a binary file) and returns its index
+        -the viewer must have a `filePath` property (see `filePathAt()`)
+        -parameters:
+            index: the index at which to place the new tab (-1 if at the end)
+        */
+
+        void replaceTab(int index, QWidget* viewer, const QString& label);
+        /*  -replaces the tab at `index` (which must not have unsaved changes) by a viewer, without changing the current tab */
+
         ScintillaEditor *current();
-        /* -access current tab object */
+        /* -access current tab object (null if the current tab is a viewer rather than an editor) */
 
         ScintillaEditor *getEditor(int i);
-        /* -access tab object using its index */
+        /* -access tab object using its index (null if the tab is a viewer rather than an editor) */
+
+        QString filePathAt(int i);
+        /*  -returns the path to the file shown in a tab, whether it is an editor or a viewer */
 
         int closeAll();
         /* -closes all open tabs/documents */
@@ -0,0 +1,93 @@
+/*
+Project: Lepton Editor
+File: fileloader.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the FileLoader class.  It reads a file in blocks,
+    on a worker thread, so that large files can be loaded into an editor a piece at a time
+    without freezing the user interface.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "fileloader.h"
+
+//include Qt classes
+#include <QFile>
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+FileLoader::FileLoader(const QString& _filePath, int _blockSize, QObject* parent) : QObject(parent), filePath(_filePath), blockSize(_blockSize), canceled(0), freeBlocks(4) {
+/*  -Class constructor */
+}
+
+void FileLoader::cancel() {
+/*  -stops reading the file as soon as possible (can be called from any thread) */
+    canceled.storeRelease(1);
+    freeBlocks.release();   //wake up the worker thread if it is waiting for a block to be used
+}
+
+void FileLoader::blockConsumed() {
+/*  -signals that a block emitted by `blockRead()` was used, so that another one may be read (can be called from any thread) */
+    freeBlocks.release();
+}
+
+
+
+//~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void FileLoader::load() {
+/*  -reads the file, emitting `blockRead()` for each block, and then emits `finished()` or `failed()` */
+    QFile file(filePath);
+    if (! file.open(QIODevice::ReadOnly) ) {
+        emit failed( file.errorString() );
+        return;
+    }
+
+    while ( canceled.loadAcquire() == 0 ) {
+        freeBlocks.acquire();   //wait until the editor has caught up
+        if ( canceled.loadAcquire() != 0 ) break;
+
+        QByteArray block = file.read(blockSize);
+        if ( block.isEmpty() ) {
+            if ( file.error() != QFileDevice::NoError ) {
+                emit failed( file.errorString() );
+                return;
+            }
+            break;
+        }
+
+        emit blockRead(block);
+    }
+
+    file.close();
+    emit finished();
+}
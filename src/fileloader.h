@@ -0,0 +1,88 @@
+/*
+Project: Lepton Editor
+File: fileloader.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the FileLoader class.  It reads a file in blocks,
+    on a worker thread, so that large files can be loaded into an editor a piece at a time
+    without freezing the user interface.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILELOADER_H
+#define FILELOADER_H
+
+//include Qt classes
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QAtomicInt>
+#include <QSemaphore>
+
+
+
+class FileLoader : public QObject {
+/*
+-A class that reads a file in blocks (meant to be moved to a worker thread).
+-Only a few blocks may be waiting to be used at any time, so that a file is never held in
+ memory twice: each block must be released with `blockConsumed()` once it has been used.
+*/
+
+    Q_OBJECT
+
+    public:
+        explicit FileLoader(const QString& _filePath, int _blockSize, QObject* parent = 0);
+        /*  -Class constructor */
+
+        void cancel();
+        /*  -stops reading the file as soon as possible (can be called from any thread) */
+
+        void blockConsumed();
+        /*  -signals that a block emitted by `blockRead()` was used, so that another one may be read (can be called from any thread) */
+
+    public slots:
+        void load();
+        /*  -reads the file, emitting `blockRead()` for each block, and then emits `finished()` or `failed()` */
+
+    signals:
+        void blockRead(const QByteArray& block);
+        /*  -emitted when a block of the file was read */
+
+        void finished();
+        /*  -emitted when the whole file was read (or when reading it was canceled) */
+
+        void failed(const QString& errorString);
+        /*  -emitted if the file could not be read */
+
+    private:
+        QString filePath;           //path to the file being read
+        int blockSize;              //number of bytes read at a time
+        QAtomicInt canceled;        //non-zero if reading the file was canceled
+        QSemaphore freeBlocks;      //number of blocks which may still be read before some are used
+};
+
+#endif // FILELOADER_H
@@ -74,6 +74,16 @@ QVariant GeneralConfig::getValue(const QString& key, const QString& subKey_1, co
 }
 
 
+QVariant GeneralConfig::getValueOrDefault(const QVariant& defaultValue, const QString& key, const QString& subKey_1, const QString& subKey_2) const {
+/*  -get the value that corresponds to the given keys, or `defaultValue` if no such value is configured */
+
+    QVariant value = getValue(key, subKey_1, subKey_2);
+
+    if ( value.isNull() ) return defaultValue;
+    else return value;
+}
+
+
 QColor GeneralConfig::getValueAsColor(const QString& key, const QString& subKey_1, const QString& subKey_2) const {
 /*
     -get the value that corresponds to the given keys and return it as a color value
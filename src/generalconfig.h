@@ -53,6 +53,9 @@ class GeneralConfig {
         QVariant getValue(const QString& key, const QString& subKey_1 = 0, const QString& subKey_2 = 0) const;
         /*  -get the value that corresponds to `key` from the JSON config data object */
 
+        QVariant getValueOrDefault(const QVariant& defaultValue, const QString& key, const QString& subKey_1 = 0, const QString& subKey_2 = 0) const;
+        /*  -get the value that corresponds to the given keys, or `defaultValue` if no such value is configured */
+
         QColor getValueAsColor(const QString& key, const QString& subKey_1 = 0, const QString& subKey_2 = 0) const;
         /*
             -get the value that corresponds to the given keys and return it as a color value
@@ -0,0 +1,439 @@
+/*
+Project: Lepton Editor
+File: grammarregistry.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the GrammarRegistry class.  It compiles language
+    files into the token rules used by `LeptonLexer` and shares the compiled rules between
+    all lexers.  It also watches the languages directory so that changes made to a language
+    file are picked up (and only the rules that changed are compiled again) while Lepton is
+    running.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "grammarregistry.h"
+
+//include Qt classes
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDomDocument>
+#include <QDomNodeList>
+#include <QTextStream>
+#include <QCryptographicHash>
+#include <QRegularExpression>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+#include "builtinlanguages.h"
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static GrammarRegistry* registry = 0;   //the registry used by all lexers (see `GrammarRegistry::getRegistry()`)
+
+static QByteArray hashOf(const QDomElement& element) {
+/*  -returns a hash of the XML of `element`, including all of its children */
+    QString xml;
+    QTextStream stream(&xml);
+    element.save(stream, 0);
+    stream.flush();
+    return QCryptographicHash::hash(xml.toUtf8(), QCryptographicHash::Md5);
+}
+
+static void useNativeMatchers(TokenRule& rule, const QHash<QString, NativeMatcher>& matchers) {
+/*  -gives `rule` and its sub-rules the native matchers in `matchers` generated for their patterns (or none) */
+    rule.nativeRule = matchers.value( rule.rule.pattern(), 0 );
+    rule.nativeCloseRule = matchers.value( rule.closeRule.pattern(), 0 );
+    for (int i = 0, count = rule.subRules.length(); i < count; i++) useNativeMatchers(rule.subRules[i], matchers);
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+GrammarRegistry* GrammarRegistry::getRegistry() {
+/*  -returns the registry used by all lexers (it is created the first time it is needed) */
+    if (registry == 0) registry = new GrammarRegistry( QCoreApplication::instance() );
+    return registry;
+}
+
+QSharedPointer<const TokenRule> GrammarRegistry::language(const QString& path) {
+/*
+-returns the root rule of the language defined in the file at `path`, compiling the file only
+ if it was not already compiled (or if it changed since)
+-the name of the root rule is the name of the language
+-returns a null pointer if the file does not define a valid language
+*/
+    if ( path.isEmpty() ) return QSharedPointer<const TokenRule>();
+
+    //languages are indexed by absolute path, so that a file is compiled once however it is referred to
+    const QString filePath = QFileInfo(path).absoluteFilePath();
+    QSharedPointer<const TokenRule> compiledLanguage = languages.value(filePath).toStrongRef();
+    if ( ! compiledLanguage.isNull() ) return compiledLanguage;
+
+    /*########################################################################################
+    ### The language is registered before it is compiled so that a language which uses or  ##
+    ### includes itself (directly or through other languages) gets the root rule being      ##
+    ### compiled instead of compiling the language again, forever.                          ##
+    ########################################################################################*/
+
+    QSharedPointer<TokenRule> root(new TokenRule);
+    languages.insert( filePath, QWeakPointer<const TokenRule>(root) );
+
+    CompileState state;
+    state.previousRules = compiledRules.value(filePath);
+    bool r = compile(filePath, *root, state);
+
+    compiledRules.insert(filePath, state.rules);
+    dependencies.insert(filePath, state.dependencies);
+    watch(filePath);
+
+    if (r == false) {
+        languages.remove(filePath);
+        return QSharedPointer<const TokenRule>();
+    }
+
+    return root;
+}
+
+void GrammarRegistry::languageReleased() {
+/*
+-tells the registry that a lexer stopped using a language, so that the rules compiled for the
+ languages which are no longer used by any lexer are forgotten (does nothing if there is no registry)
+*/
+
+    /*########################################################################################
+    ### Lexers release their language when they are destroyed, which may happen after the  ##
+    ### registry itself was destroyed (with the application), so the registry is not       ##
+    ### created here.  Unused languages are forgotten from the event loop so that closing   ##
+    ### several editors at once only goes through the compiled languages once.              ##
+    ########################################################################################*/
+
+    if (registry != 0) registry->releaseTimer.start();
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+GrammarRegistry::GrammarRegistry(QObject* parent) : QObject(parent) {
+/*  -Class constructor (use `getRegistry()` to get the registry) */
+
+    //changes are handled a moment after they happen since saving a file often changes it several times
+    reloadTimer.setSingleShot(true);
+    reloadTimer.setInterval(200);
+    connect(&reloadTimer, SIGNAL(timeout()), this, SLOT(reloadChangedFiles()));
+
+    releaseTimer.setSingleShot(true);
+    releaseTimer.setInterval(0);
+    connect(&releaseTimer, SIGNAL(timeout()), this, SLOT(forgetUnusedLanguages()));
+
+    connect(&watcher, SIGNAL(fileChanged(QString)), this, SLOT(fileChanged(QString)));
+    connect(&watcher, SIGNAL(directoryChanged(QString)), this, SLOT(directoryChanged(QString)));
+
+    QString languagesDirPath = LeptonConfig::mainSettings->getLangsDirPath();
+    if ( QDir(languagesDirPath).exists() ) watcher.addPath(languagesDirPath);
+}
+
+GrammarRegistry::~GrammarRegistry() {
+/*  -Class destructor */
+    registry = 0;
+}
+
+bool GrammarRegistry::compile(const QString& filePath, TokenRule& root, CompileState& state) {
+/*
+-builds the tokenization rules of the language defined in a file into `root`
+-returns true if the data was successfully extracted, false otherwise
+*/
+
+    //read the file containing the language tokenization rules (stored in xml)
+    QFile languageFile(filePath);
+    if (! languageFile.open(QIODevice::ReadOnly) ) return false;
+    QByteArray languageData = languageFile.readAll();
+    languageFile.close();
+
+    QDomDocument langDoc("language_document");
+    if (! langDoc.setContent(languageData) ) return false;
+
+    //get the documents root element
+    QDomElement rootElement = langDoc.documentElement();
+    if ( rootElement.nodeName() != "language" ) return false;
+
+    //start with the rules of the language used by this language, if any
+    QString usedFile = rootElement.attribute("use", QString());
+    if ( ! usedFile.isEmpty() ) {
+        QString usedFilePath = LeptonConfig::mainSettings->getLangFilePath(usedFile);
+        state.dependencies.insert( QFileInfo(usedFilePath).absoluteFilePath() );
+        QSharedPointer<const TokenRule> usedLanguage = language(usedFilePath);
+        if ( usedLanguage.isNull() ) return false;
+        root.subRules = usedLanguage->subRules;
+    }
+    const int usedRuleCount = root.subRules.length();
+
+    //get the name of the language (displayed in menu)
+    if ( !rootElement.hasAttribute("name") || rootElement.attribute("name").isEmpty() ) return false;
+    root.name = rootElement.attribute("name");
+
+    //get the element that containes all tokenization rule definitions
+    if ( rootElement.lastChildElement("tokenization").isNull() ) return false;
+    QDomElement tokenizationRules = rootElement.lastChildElement("tokenization");
+
+    //check if any keywords are defined and, if so, extract them
+    QDomNodeList ruleElements = tokenizationRules.elementsByTagName("keywords");
+    for (int i = 0, count = ruleElements.count(); i < count; i++) {
+        QDomElement rule = ruleElements.at(i).toElement();
+        int ruleClass = rule.attribute("class").toInt();
+        if (ruleClass < 0 || ruleClass > 31 ) continue;
+
+        //keyword lists can be very long so they are only compiled again if they changed
+        QByteArray key = hashOf(rule);
+        if ( state.previousRules.contains(key) || state.rules.contains(key) ) {
+            TokenRule cachedRule = state.rules.contains(key) ? state.rules.value(key) : state.previousRules.value(key);
+            state.rules.insert(key, cachedRule);
+            root.subRules.append(cachedRule);
+            continue;
+        }
+
+        TokenRule newRule;
+        newRule.name = "KEYWORD";
+        newRule.id = ruleClass;
+        QString exp = rule.firstChild().nodeValue().simplified().replace( QRegularExpression("\\s"), "|").prepend("^\\b(").append(")\\b");
+        newRule.rule.setPattern(exp);
+        if ( ! newRule.rule.isValid() ) continue;
+        state.rules.insert(key, newRule);
+        root.subRules.append(newRule);
+    }
+
+    //check if numbers are used and, if so, implement them
+    if (! tokenizationRules.lastChildElement("numbers").isNull() ) {
+        int ruleClass = tokenizationRules.lastChildElement("numbers").attribute("class").toInt();
+        if ( ruleClass >= 0 && ruleClass <= 31) {
+            TokenRule newRule;
+            newRule.name = "NUMBER";
+            newRule.id = ruleClass;
+            QString exp = "^(\\b\\d+\\b)";
+            newRule.rule.setPattern(exp);
+            if ( newRule.rule.isValid() ) root.subRules.append(newRule);
+        }
+    }
+
+    //extract all other tokenization rules defined purly using regular expressions
+    extractRulesFrom(tokenizationRules, root.subRules, state);
+
+    /*#########################################################################################
+    ### The patterns of the language files bundled with Lepton are turned into native state  ##
+    ### machines at build time (see builtinlanguages.h).  They are only used if the file is  ##
+    ### exactly the one Lepton was built with; the rules of a modified or custom file only   ##
+    ### use their regular expressions.  The rules of the language this one uses got their    ##
+    ### matchers (or not) when that language was compiled.                                   ##
+    #########################################################################################*/
+
+    QHash<QString, NativeMatcher> nativeMatchers;
+    const BuiltinLanguage* builtinLanguage = findBuiltinLanguage( QCryptographicHash::hash(languageData, QCryptographicHash::Sha1).toHex() );
+    if (builtinLanguage != 0) {
+        for (int i = 0; i < builtinLanguage->matcherCount; i++) {
+            nativeMatchers.insert( QString::fromUtf8(builtinLanguage->matchers[i].pattern), builtinLanguage->matchers[i].match );
+        }
+    }
+    for (int i = usedRuleCount, count = root.subRules.length(); i < count; i++) useNativeMatchers(root.subRules[i], nativeMatchers);
+
+    return true;
+}
+
+void GrammarRegistry::extractRulesFrom(const QDomElement& tokenizationRules, TokenRuleList& rList, CompileState& state) {
+/*
+-extracts all tokenization rules from `rule` and `spanrule` elements in `tokenizationRules`
+ and adds them to rList
+-rules whose XML did not change since the file was last compiled are not compiled again
+*/
+
+    /*##########################################################################################
+    ### Every rule compiled from the file is kept, indexed by a hash of its XML (children     ##
+    ### included).  When the file is compiled again, a rule whose XML is identical is reused  ##
+    ### as is: copies of a `QRegularExpression` share the compiled pattern, so only the rules ##
+    ### that were actually edited get compiled.  Span rules which include another language   ##
+    ### are always rebuilt, since the included language may have changed even if their XML   ##
+    ### did not.                                                                              ##
+    ##########################################################################################*/
+
+    QDomNodeList nodes = tokenizationRules.childNodes();
+    for (int i = 0, count = nodes.count(); i < count; i++) {
+        if ( ! nodes.at(i).isElement() ) continue;
+        QDomElement ruleElement = nodes.at(i).toElement();
+        if ( ruleElement.tagName() != "rule" && ruleElement.tagName() != "spanrule" ) continue;
+
+        int ruleClass = ruleElement.attribute("class").toInt();
+        if (ruleClass < 0 || ruleClass > 31 ) continue;
+
+        QByteArray key = hashOf(ruleElement);
+        if ( state.previousRules.contains(key) || state.rules.contains(key) ) {
+            TokenRule cachedRule = state.rules.contains(key) ? state.rules.value(key) : state.previousRules.value(key);
+            state.rules.insert(key, cachedRule);
+            rList.append(cachedRule);
+            continue;
+        }
+
+        TokenRule newRule;
+        newRule.name = ruleElement.attribute("name");
+        newRule.id = ruleClass;
+
+        if (ruleElement.tagName() == "rule") {
+            QString exp = ruleElement.firstChild().nodeValue().prepend("^(").append(")");
+            newRule.rule.setPattern(exp);
+            if ( ! newRule.rule.isValid() ) continue;
+        }
+        else {
+            QString exp = ruleElement.lastChildElement("open").firstChild().nodeValue().prepend("^(").append(")");
+            newRule.rule.setPattern(exp);
+            exp = ruleElement.lastChildElement("close").firstChild().nodeValue().prepend("^(").append(")");
+            newRule.closeRule.setPattern(exp);
+            if ( ! newRule.rule.isValid() || ! newRule.closeRule.isValid() ) continue;
+            extractRulesFrom(ruleElement, newRule.subRules, state);
+            QDomElement includeElement = ruleElement.lastChildElement("include");
+            if ( ! includeElement.isNull() ) newRule.include = includedLanguage( includeElement.attribute("language"), state );
+        }
+
+        if ( ruleElement.elementsByTagName("include").isEmpty() ) state.rules.insert(key, newRule);
+        rList.append(newRule);
+    }
+}
+
+QSharedPointer<const TokenRule> GrammarRegistry::includedLanguage(const QString& fileName, CompileState& state) {
+/*  -returns the root rule of the language included (by a span rule) from `fileName` in the languages directory */
+
+    /*#########################################################################################
+    ### A language embedded in other languages (ex. JavaScript in HTML) is compiled once and ##
+    ### its root rule is shared, by pointer, by every span rule which includes it, in every  ##
+    ### lexer.  While tokenizing, the included rules are found through the span rule on top ##
+    ### of the rule stack, so switching to the embedded language does not copy any rules.   ##
+    #########################################################################################*/
+
+    const QString filePath = LeptonConfig::mainSettings->getLangFilePath(fileName);
+    state.dependencies.insert( QFileInfo(filePath).absoluteFilePath() );
+
+    QSharedPointer<const TokenRule> root = language(filePath);
+    if ( root.isNull() ) root = QSharedPointer<const TokenRule>(new TokenRule);   //include nothing if the language is not valid
+    return root;
+}
+
+void GrammarRegistry::watch(const QString& filePath) {
+/*  -starts watching `filePath` for changes, if it is not already watched */
+    if ( QFileInfo(filePath).exists() && ! watcher.files().contains(filePath) ) watcher.addPath(filePath);
+}
+
+
+
+//~private slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void GrammarRegistry::fileChanged(const QString& filePath) {
+/*  -records that a language file changed and schedules the languages to be reloaded */
+    changedFiles.insert(filePath);
+    watch(filePath);    //a file which was replaced is no longer watched
+    reloadTimer.start();
+}
+
+void GrammarRegistry::directoryChanged(const QString& dirPath) {
+/*  -checks for compiled language files which were replaced (ex. saved by renaming a temporary file) */
+    Q_UNUSED(dirPath);
+
+    QStringList watchedFiles = watcher.files();
+    foreach (const QString& filePath, compiledRules.keys()) {
+        if ( QFileInfo(filePath).exists() && ! watchedFiles.contains(filePath) ) {
+            watcher.addPath(filePath);
+            changedFiles.insert(filePath);
+            reloadTimer.start();
+        }
+    }
+}
+
+void GrammarRegistry::reloadChangedFiles() {
+/*  -forgets the languages affected by the files that changed and notifies the lexers using them */
+    QSet<QString> affectedFiles = changedFiles;
+    changedFiles.clear();
+
+    //languages which use or include an affected language are affected too
+    bool added = true;
+    while (added) {
+        added = false;
+        for (QHash< QString, QSet<QString> >::const_iterator i = dependencies.constBegin(); i != dependencies.constEnd(); ++i) {
+            if ( ! affectedFiles.contains(i.key()) && i.value().intersects(affectedFiles) ) {
+                affectedFiles.insert( i.key() );
+                added = true;
+            }
+        }
+    }
+
+    /*########################################################################################
+    ### The affected languages are only forgotten here.  They are compiled again (reusing   ##
+    ### the rules that did not change) the first time a lexer asks for them, which lexers   ##
+    ### that use them do when they are notified.                                            ##
+    ########################################################################################*/
+
+    QStringList reloadedFiles;
+    foreach (const QString& filePath, affectedFiles) {
+        if ( languages.remove(filePath) > 0 ) reloadedFiles.append(filePath);
+    }
+
+    foreach (const QString& filePath, reloadedFiles) {
+        emit languageChanged(filePath);
+    }
+}
+
+void GrammarRegistry::forgetUnusedLanguages() {
+/*  -forgets the rules compiled for the languages which are no longer used by any lexer and stops watching their files */
+
+    /*########################################################################################
+    ### The registry only keeps weak pointers to the languages it compiled: a language is  ##
+    ### used for as long as a lexer (or a span rule including it) holds its root rule.     ##
+    ### Once it is not, the rules compiled from its file, which are otherwise kept to be   ##
+    ### reused when the file changes, are forgotten too.                                   ##
+    ########################################################################################*/
+
+    foreach (const QString& filePath, compiledRules.keys()) {
+        if ( ! languages.value(filePath).isNull() ) continue;
+        languages.remove(filePath);
+        compiledRules.remove(filePath);
+        dependencies.remove(filePath);
+    }
+
+    //keep watching the files that the languages still in use depend on (ex. a language they use)
+    QSet<QString> usedFiles;
+    for (QHash< QString, QSet<QString> >::const_iterator i = dependencies.constBegin(); i != dependencies.constEnd(); ++i) {
+        usedFiles.insert( i.key() );
+        usedFiles.unite( i.value() );
+    }
+
+    foreach (const QString& filePath, watcher.files()) {
+        if ( ! usedFiles.contains(filePath) ) watcher.removePath(filePath);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+Project: Lepton Editor
+File: grammarregistry.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the GrammarRegistry class.  It compiles language
+    files into the token rules used by `LeptonLexer` and shares the compiled rules between
+    all lexers.  It also watches the languages directory so that changes made to a language
+    file are picked up (and only the rules that changed are compiled again) while Lepton is
+    running.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GRAMMARREGISTRY_H
+#define GRAMMARREGISTRY_H
+
+//include Qt classes
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <QDomElement>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+//include other Lepton files needed by this class
+#include "leptonlexer.h"
+
+
+
+class GrammarRegistry : public QObject {
+/* -A class that compiles language files into token rules and shares them between all lexers. */
+
+    Q_OBJECT
+
+    public:
+        static GrammarRegistry* getRegistry();
+        /*  -returns the registry used by all lexers (it is created the first time it is needed) */
+
+        QSharedPointer<const TokenRule> language(const QString& path);
+        /*
+            -returns the root rule of the language defined in the file at `path`, compiling the file only
+             if it was not already compiled (or if it changed since)
+            -the name of the root rule is the name of the language
+            -returns a null pointer if the file does not define a valid language
+        */
+
+        static void languageReleased();
+        /*
+            -tells the registry that a lexer stopped using a language, so that the rules compiled for the
+             languages which are no longer used by any lexer are forgotten (does nothing if there is no registry)
+        */
+
+    signals:
+        void languageChanged(const QString& filePath);
+        /*
+            -emitted when a compiled language is out of date because its file (or a file it uses or includes) changed
+            -`filePath` is the absolute path of the language file
+        */
+
+    private:
+        struct CompileState {
+                QHash<QByteArray, TokenRule> previousRules;    //rules compiled the last time the file was compiled
+                QHash<QByteArray, TokenRule> rules;            //rules compiled (or reused) this time
+                QSet<QString> dependencies;                    //files used or included by the language
+        };
+
+        QHash< QString, QWeakPointer<const TokenRule> > languages;     //compiled languages, for as long as lexers use them (indexed by file path)
+        QHash< QString, QHash<QByteArray, TokenRule> > compiledRules;  //rules compiled from each file (indexed by a hash of their XML)
+        QHash< QString, QSet<QString> > dependencies;                   //files used or included by each compiled language
+        QFileSystemWatcher watcher;                                     //watches the language files and their directory
+        QTimer reloadTimer;                                             //timer used to handle changes to several files at once
+        QTimer releaseTimer;                                            //timer used to forget unused languages once lexers released them
+        QSet<QString> changedFiles;                                     //language files which changed since the last reload
+
+        explicit GrammarRegistry(QObject* parent = 0);
+        /*  -Class constructor (use `getRegistry()` to get the registry) */
+
+        ~GrammarRegistry();
+        /*  -Class destructor */
+
+        bool compile(const QString& filePath, TokenRule& root, CompileState& state);
+        /*
+            -builds the tokenization rules of the language defined in a file into `root`
+            -returns true if the data was successfully extracted, false otherwise
+        */
+
+        void extractRulesFrom(const QDomElement& tokenizationElement, TokenRuleList& rList, CompileState& state);
+        /*
+            -extracts all tokenization rules from `rule` and `spanrule` elements in `tokenizationElement`
+             and adds them to rList
+            -rules whose XML did not change since the file was last compiled are not compiled again
+        */
+
+        QSharedPointer<const TokenRule> includedLanguage(const QString& fileName, CompileState& state);
+        /*  -returns the root rule of the language included (by a span rule) from `fileName` in the languages directory */
+
+        void watch(const QString& filePath);
+        /*  -starts watching `filePath` for changes, if it is not already watched */
+
+    private slots:
+        void fileChanged(const QString& filePath);
+        /*  -records that a language file changed and schedules the languages to be reloaded */
+
+        void directoryChanged(const QString& dirPath);
+        /*  -checks for compiled language files which were replaced (ex. saved by renaming a temporary file) */
+
+        void reloadChangedFiles();
+        /*  -forgets the languages affected by the files that changed and notifies the lexers using them */
+
+        void forgetUnusedLanguages();
+        /*  -forgets the rules compiled for the languages which are no longer used by any lexer and stops watching their files */
+};
+
+#endif // GRAMMARREGISTRY_H
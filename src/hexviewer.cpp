@@ -0,0 +1,198 @@
+/*
+Project: Lepton Editor
+File: hexviewer.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the HexViewer class.  It shows the bytes of a
+    binary file, reading only the rows which are visible.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "hexviewer.h"
+
+//include Qt classes
+#include <QPainter>
+#include <QPaintEvent>
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <QFontMetrics>
+#include <QMessageBox>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include other standard library classes
+#include <climits>
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+HexViewer::HexViewer(QWidget* parent) : QAbstractScrollArea(parent), rowsPerStep(1) {
+/*  -Class constructor */
+    font = LeptonConfig::mainSettings->getDefaultEditorFont();
+    textColor = LeptonConfig::mainSettings->getValueAsColor("editor_theme", "text_color");
+    paperColor = LeptonConfig::mainSettings->getValueAsColor("editor_theme", "paper_color");
+    offsetColor = LeptonConfig::mainSettings->getValueAsColor("editor_theme", "margins_foreground");
+    offsetPaperColor = LeptonConfig::mainSettings->getValueAsColor("editor_theme", "margins_background");
+
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setFocusPolicy(Qt::StrongFocus);
+}
+
+bool HexViewer::openFile(const QString& _filePath) {
+/*  -shows the bytes of a file; returns false (after warning the user) if it can not be opened */
+    if ( !file.open(_filePath) ) {
+        QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot open file %1:\n%2.").arg(_filePath).arg(file.errorString()));
+        return false;
+    }
+
+    filePath = _filePath;
+    verticalScrollBar()->setValue(0);
+    updateScrollBars();
+    viewport()->update();
+    return true;
+}
+
+QString HexViewer::getOpenFilePath() {
+/*  -returns the path to the file being shown */
+    return filePath;
+}
+
+
+
+//~protected methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void HexViewer::paintEvent(QPaintEvent* event) {
+/*  -draws the rows of bytes which are visible */
+    QPainter painter( viewport() );
+    painter.fillRect(event->rect(), paperColor);
+    painter.setFont(font);
+
+    const QFontMetrics metrics(font);
+    const int rowHeight = metrics.height();
+    const int charWidth = metrics.width('0');
+    const int offsetDigits = file.size() > Q_INT64_C(0xFFFFFFFF) ? 16 : 8;
+    const int offsetWidth = (offsetDigits + 2) * charWidth;
+    const int x = -horizontalScrollBar()->value();
+
+    painter.fillRect(QRect(x, 0, offsetWidth - charWidth, viewport()->height()), offsetPaperColor);
+
+    //only the bytes of the visible rows are mapped (and read)
+    const qint64 firstByte = topRow() * bytesPerRow;
+    if ( firstByte >= file.size() ) return;
+    const qint64 length = qMin(file.size() - firstByte, qint64( visibleRows() + 1 ) * bytesPerRow);
+    const uchar* data = file.map(firstByte, length);
+    if (data == 0) return;
+
+    static const char digits[] = "0123456789abcdef";
+    for (qint64 row = 0; row * bytesPerRow < length; row++) {
+        const int y = int(row) * rowHeight + metrics.ascent();
+        const uchar* bytes = data + row * bytesPerRow;
+        const int count = int( qMin(qint64(bytesPerRow), length - row * bytesPerRow) );
+
+        painter.setPen(offsetColor);
+        painter.drawText(x, y, QString("%1").arg(firstByte + row * bytesPerRow, offsetDigits, 16, QChar('0')));
+
+        //the bytes in hexadecimal (with a gap after the first half of the row), followed by the printable ones as ASCII
+        QString hex;
+        QString ascii;
+        hex.reserve(bytesPerRow * 3 + 1);
+        ascii.reserve(bytesPerRow);
+        for (int i = 0; i < bytesPerRow; i++) {
+            if (i == bytesPerRow / 2) hex.append(' ');
+            if (i < count) {
+                hex.append( QLatin1Char(digits[bytes[i] >> 4]) ).append( QLatin1Char(digits[bytes[i] & 0xF]) ).append(' ');
+                ascii.append( bytes[i] >= 0x20 && bytes[i] < 0x7F ? QChar(bytes[i]) : QChar('.') );
+            }
+            else hex.append("   ");
+        }
+
+        painter.setPen(textColor);
+        painter.drawText(x + offsetWidth, y, hex);
+        painter.drawText(x + offsetWidth + (hex.length() + 1) * charWidth, y, ascii);
+    }
+}
+
+void HexViewer::resizeEvent(QResizeEvent* event) {
+/*  -updates the scroll bars for the new number of visible rows */
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void HexViewer::keyPressEvent(QKeyEvent* event) {
+/*  -moves to the start or the end of the file on Ctrl+Home and Ctrl+End */
+    if ( event->matches(QKeySequence::MoveToStartOfDocument) ) verticalScrollBar()->triggerAction(QAbstractSlider::SliderToMinimum);
+    else if ( event->matches(QKeySequence::MoveToEndOfDocument) ) verticalScrollBar()->triggerAction(QAbstractSlider::SliderToMaximum);
+    else QAbstractScrollArea::keyPressEvent(event);
+}
+
+void HexViewer::scrollContentsBy(int dx, int dy) {
+/*  -redraws the view when it was scrolled */
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    viewport()->update();
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+qint64 HexViewer::rowCount() {
+/*  -returns the number of rows needed to show the whole file */
+    return (file.size() + bytesPerRow - 1) / bytesPerRow;
+}
+
+int HexViewer::visibleRows() {
+/*  -returns the number of rows which fit in the view */
+    return qMax(1, viewport()->height() / QFontMetrics(font).height());
+}
+
+qint64 HexViewer::topRow() {
+/*  -returns the first row shown */
+    return qMin( qint64( verticalScrollBar()->value() ) * rowsPerStep, qMax(qint64(0), rowCount() - visibleRows()) );
+}
+
+void HexViewer::updateScrollBars() {
+/*  -sets the range of the scroll bars to the size of the file */
+
+    //scroll bars count in ints, so for files with more rows than that, each step of the scroll bar moves several rows
+    const qint64 lastTopRow = qMax(qint64(0), rowCount() - visibleRows());
+    rowsPerStep = lastTopRow / INT_MAX + 1;
+    verticalScrollBar()->setRange(0, int(lastTopRow / rowsPerStep + (lastTopRow % rowsPerStep != 0 ? 1 : 0)));
+    verticalScrollBar()->setPageStep( qMax(1, int(visibleRows() / rowsPerStep)) );
+    verticalScrollBar()->setSingleStep(1);
+
+    const QFontMetrics metrics(font);
+    const int offsetDigits = file.size() > Q_INT64_C(0xFFFFFFFF) ? 16 : 8;
+    const int rowWidth = (offsetDigits + 2 + bytesPerRow * 3 + 2 + bytesPerRow) * metrics.width('0');
+    horizontalScrollBar()->setRange(0, qMax(0, rowWidth - viewport()->width()));
+    horizontalScrollBar()->setPageStep( viewport()->width() );
+}
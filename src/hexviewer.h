@@ -0,0 +1,105 @@
+/*
+Project: Lepton Editor
+File: hexviewer.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the HexViewer class.  It is a read-only view of a
+    binary file, shown as rows of bytes in hexadecimal and as ASCII characters.  The file
+    is mapped into memory a window at a time, so even files of several gigabytes open
+    instantly and only the rows on screen are ever read.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEXVIEWER_H
+#define HEXVIEWER_H
+
+//include Qt classes
+#include <QAbstractScrollArea>
+#include <QString>
+#include <QColor>
+#include <QFont>
+
+//include Lepton files which are needed by this class
+#include "mappedfile.h"
+
+
+
+class HexViewer : public QAbstractScrollArea {
+/*  -A read-only tab showing the bytes of a (binary) file. */
+
+    Q_OBJECT
+    Q_PROPERTY(QString filePath READ getOpenFilePath)
+
+    public:
+        explicit HexViewer(QWidget* parent = 0);
+        /*  -Class constructor */
+
+        bool openFile(const QString& filePath);
+        /*  -shows the bytes of a file; returns false (after warning the user) if it can not be opened */
+
+        QString getOpenFilePath();
+        /*  -returns the path to the file being shown */
+
+        static const int bytesPerRow = 16;
+
+    protected:
+        void paintEvent(QPaintEvent* event);
+        /*  -draws the rows of bytes which are visible */
+
+        void resizeEvent(QResizeEvent* event);
+        /*  -updates the scroll bars for the new number of visible rows */
+
+        void keyPressEvent(QKeyEvent* event);
+        /*  -moves to the start or the end of the file on Ctrl+Home and Ctrl+End */
+
+        void scrollContentsBy(int dx, int dy);
+        /*  -redraws the view when it was scrolled */
+
+    private:
+        MappedFile file;            //file being shown
+        QString filePath;           //path to the file being shown
+        QFont font;                 //font the bytes are drawn with
+        QColor textColor;           //color of the bytes
+        QColor paperColor;          //background color
+        QColor offsetColor;         //color of the offsets at the start of the rows
+        QColor offsetPaperColor;    //background color of the offsets
+        qint64 rowsPerStep;         //number of rows moved by one step of the scroll bar (more than one only for huge files)
+
+        qint64 rowCount();
+        /*  -returns the number of rows needed to show the whole file */
+
+        int visibleRows();
+        /*  -returns the number of rows which fit in the view */
+
+        qint64 topRow();
+        /*  -returns the first row shown */
+
+        void updateScrollBars();
+        /*  -sets the range of the scroll bars to the size of the file */
+};
+
+#endif // HEXVIEWER_H
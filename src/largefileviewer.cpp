@@ -0,0 +1,540 @@
+/*
+Project: Lepton Editor
+File: largefileviewer.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LargeFileViewer class.  It is a read-only view
+    of a text file too large to be loaded into an editor, which only copies the lines on screen
+    out of the (memory mapped) file and indexes its lines in the background.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//include this file's header
+#include "largefileviewer.h"
+
+//include Qt classes
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QWheelEvent>
+#include <QKeyEvent>
+#include <QMessageBox>
+#include <QFileInfo>
+#include <QLocale>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include other standard library classes
+#include <cstring>
+#include <algorithm>
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LargeFileViewer::LargeFileViewer(QWidget* parent) : QWidget(parent) {
+/*  -Class constructor */
+    qRegisterMetaType< QVector<qint64> >("QVector<qint64>");
+
+    indexerThread = 0;
+    indexer = 0;
+    indexedLines = 0;
+    indexedBytes = 0;
+    indexComplete = false;
+    topOffset = 0;
+    topLine = 0;
+    pendingLine = -1;
+    searchCaseSensitive = false;
+    searchStart = 0;
+    searchPosition = 0;
+    searchWrapped = false;
+    matchOffset = -1;
+
+    //the lines on screen are shown in a read-only editor whose own scroll bar is replaced by one over the whole file
+    view = new QsciScintilla(this);
+    view->setUtf8(true);
+    view->setReadOnly(true);
+    view->setUndoCollection(false);
+    view->SendScintilla(QsciScintillaBase::SCI_SETVSCROLLBAR, 0UL);
+    view->setMarginWidth(0, 0);
+    view->setMarginType(1, QsciScintilla::TextMargin);     //lines are numbered by the viewer, since the view only holds a few of them
+    view->setMarginsBackgroundColor( LeptonConfig::mainSettings->getValueAsColor("editor_theme", "margins_background") );
+    view->setMarginsForegroundColor( LeptonConfig::mainSettings->getValueAsColor("editor_theme", "margins_foreground") );
+    view->setCaretForegroundColor( LeptonConfig::mainSettings->getValueAsColor("editor_theme", "caret_color") );
+    view->setSelectionBackgroundColor( LeptonConfig::mainSettings->getValueAsColor("editor_theme", "selection_background") );
+    view->setSelectionForegroundColor( LeptonConfig::mainSettings->getValueAsColor("editor_theme", "selection_foreground") );
+    view->installEventFilter(this);
+    view->viewport()->installEventFilter(this);
+    lexerManager = new SyntaxHighlightManager(view);
+
+    scrollBar = new QScrollBar(Qt::Vertical, this);
+    connect(scrollBar, SIGNAL(actionTriggered(int)), this, SLOT(scrollBarAction(int)));
+    connect(scrollBar, SIGNAL(sliderMoved(int)), this, SLOT(scrollBarMoved(int)));
+
+    statusLabel = new QLabel(this);
+
+    QHBoxLayout* viewLayout = new QHBoxLayout();
+    viewLayout->setContentsMargins(0, 0, 0, 0);
+    viewLayout->setSpacing(0);
+    viewLayout->addWidget(view);
+    viewLayout->addWidget(scrollBar);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(viewLayout);
+    layout->addWidget(statusLabel);
+
+    //the file is searched a slice at a time from the event loop, so the viewer stays responsive
+    searchTimer.setSingleShot(true);
+    searchTimer.setInterval(0);
+    connect(&searchTimer, SIGNAL(timeout()), this, SLOT(continueSearch()));
+
+    setFocusProxy(view);
+}
+
+LargeFileViewer::~LargeFileViewer() {
+/*  -Class destructor (stops indexing the file) */
+    searchTimer.stop();
+    stopIndexer();
+}
+
+bool LargeFileViewer::openFile(const QString& _filePath) {
+/*  -shows a file; returns false (after warning the user) if it can not be opened */
+    if ( !file.open(_filePath) ) {
+        QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot open file %1:\n%2.").arg(_filePath).arg(file.errorString()));
+        return false;
+    }
+
+    stopIndexer();
+    searchTimer.stop();
+    filePath = _filePath;
+    lineIndex.clear();
+    indexedLines = 0;
+    indexedBytes = 0;
+    indexComplete = false;
+    topOffset = 0;
+    pendingLine = -1;
+    matchOffset = -1;
+    searchStatus.clear();
+
+    lexerManager->setLexerForFile( QFileInfo(filePath).fileName() );
+
+    //the lines are indexed on a worker thread, so the start of the file can be read while the rest is being scanned
+    indexerThread = new QThread(this);
+    indexer = new LineIndexer(filePath, linesPerEntry);
+    indexer->moveToThread(indexerThread);
+
+    connect(indexerThread, SIGNAL(started()), indexer, SLOT(index()));
+    connect(indexer, SIGNAL(indexed(QVector<qint64>,qint64,qint64)), this, SLOT(addIndexEntries(QVector<qint64>,qint64,qint64)));
+    connect(indexer, SIGNAL(finished()), this, SLOT(indexingDone()));
+
+    indexerThread->start();
+
+    showWindow();
+    updateStatus();
+    return true;
+}
+
+QString LargeFileViewer::getOpenFilePath() {
+/*  -returns the path to the file being shown */
+    return filePath;
+}
+
+QMenu* LargeFileViewer::getLanguageMenu() {
+/*  -returns the language selection menu */
+    return lexerManager->getLanguageMenu();
+}
+
+void LargeFileViewer::gotoLine(qint64 line) {
+/*  -shows the line `line` (counted from 0) at the top of the view, as soon as the index of the lines reaches it */
+    const qint64 offset = offsetOfLine(line);
+    if (offset < 0) {
+        pendingLine = line;     //gone to once it is indexed
+        updateStatus();
+        return;
+    }
+
+    pendingLine = -1;
+    topOffset = offset;
+    showWindow();
+    view->setCursorPosition(0, 0);
+    updateStatus();
+}
+
+void LargeFileViewer::find(const QString& text, bool caseSensitive) {
+/*  -searches the file for `text`, from the last match (or the top of the view) on, wrapping around at its end */
+    searchTimer.stop();
+    searchCaseSensitive = caseSensitive;
+    searchText = caseSensitive ? text.toUtf8() : text.toUtf8().toLower();
+    if ( searchText.isEmpty() ) return;
+
+    searchStart = matchOffset >= 0 ? matchOffset + 1 : topOffset;
+    searchPosition = searchStart;
+    searchWrapped = false;
+    searchTimer.start();
+}
+
+void LargeFileViewer::findNext() {
+/*  -searches the file for the next match of the last text searched */
+    if ( searchText.isEmpty() ) return;
+
+    searchTimer.stop();
+    searchStart = matchOffset >= 0 ? matchOffset + 1 : topOffset;
+    searchPosition = searchStart;
+    searchWrapped = false;
+    searchTimer.start();
+}
+
+
+
+//~protected methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+bool LargeFileViewer::eventFilter(QObject* watched, QEvent* event) {
+/*  -scrolls the file when the wheel is turned or the navigation keys are pressed over the view */
+    if ( event->type() == QEvent::Wheel && static_cast<QWheelEvent*>(event)->angleDelta().y() != 0 ) {
+        scrollByLines( -static_cast<QWheelEvent*>(event)->angleDelta().y() / 120 * 3 );
+        return true;
+    }
+
+    if ( (watched == view || watched == view->viewport()) && event->type() == QEvent::KeyPress ) {
+        QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+        if ( keyEvent->matches(QKeySequence::MoveToStartOfDocument) ) {
+            scrollBar->triggerAction(QAbstractSlider::SliderToMinimum);
+            return true;
+        }
+        if ( keyEvent->matches(QKeySequence::MoveToEndOfDocument) ) {
+            scrollBar->triggerAction(QAbstractSlider::SliderToMaximum);
+            return true;
+        }
+        switch ( keyEvent->key() ) {
+            case Qt::Key_Down:      scrollByLines(1); return true;
+            case Qt::Key_Up:        scrollByLines(-1); return true;
+            case Qt::Key_PageDown:  scrollByLines( qMax(1, visibleLines() - 1) ); return true;
+            case Qt::Key_PageUp:    scrollByLines( -qMax(1, visibleLines() - 1) ); return true;
+            default: break;
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void LargeFileViewer::resizeEvent(QResizeEvent* event) {
+/*  -shows as many lines as fit in the new size */
+    QWidget::resizeEvent(event);
+    showWindow();
+}
+
+
+
+//~private slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void LargeFileViewer::addIndexEntries(const QVector<qint64>& entries, qint64 lineCount, qint64 bytesIndexed) {
+/*  -adds entries found by the indexer to the index of the lines */
+    lineIndex += entries;
+    indexedLines = lineCount;
+    indexedBytes = bytesIndexed;
+
+    if (pendingLine >= 0 && pendingLine <= indexedLines) gotoLine(pendingLine);
+    else if (topLine < 0 && topOffset <= indexedBytes) showWindow();    //the lines shown can now be numbered
+    updateStatus();
+}
+
+void LargeFileViewer::indexingDone() {
+/*  -called when the whole file was indexed */
+    indexComplete = indexedBytes >= file.size();
+    stopIndexer();
+
+    if (pendingLine >= 0 && indexComplete) gotoLine(pendingLine);     //past the last line, the last one is shown
+    updateStatus();
+}
+
+void LargeFileViewer::scrollBarAction(int action) {
+/*  -scrolls by lines or by pages when the arrows of the scroll bar, or the bar itself, are clicked */
+
+    //the scroll bar is proportional to the size of the file, so a step of it may be less (or much more) than a line
+    switch (action) {
+        case QAbstractSlider::SliderSingleStepAdd:  scrollByLines(1); break;
+        case QAbstractSlider::SliderSingleStepSub:  scrollByLines(-1); break;
+        case QAbstractSlider::SliderPageStepAdd:    scrollByLines( qMax(1, visibleLines() - 1) ); break;
+        case QAbstractSlider::SliderPageStepSub:    scrollByLines( -qMax(1, visibleLines() - 1) ); break;
+        case QAbstractSlider::SliderToMinimum:
+            topOffset = 0;
+            showWindow();
+            break;
+        case QAbstractSlider::SliderToMaximum:
+            topOffset = lineStartAt( file.size() );
+            scrollByLines( -(visibleLines() - 1) );
+            break;
+        default: return;
+    }
+    scrollBar->setSliderPosition( scrollBar->value() );     //the position was already set by `showWindow()`
+}
+
+void LargeFileViewer::scrollBarMoved(int value) {
+/*  -shows the part of the file the scroll bar was dragged to */
+    const qint64 offset = file.size() * value / qMax(1, scrollBar->maximum());
+    topOffset = lineStartAt( qMin(offset, file.size()) );
+    showWindow();
+}
+
+void LargeFileViewer::continueSearch() {
+/*  -searches the next slice of the file for the text searched */
+
+    /*######################################################################################
+    ### The file is searched in slices of its memory map, without copying a case         ##
+    ### sensitive search.  Slices overlap by the length of the text searched (less one   ##
+    ### byte), so matches which straddle two slices are found too.                        ##
+    ######################################################################################*/
+
+    const qint64 sliceSize = 16777216;
+    const qint64 end = searchWrapped ? searchStart : file.size();
+
+    if (searchPosition >= end) {
+        if (!searchWrapped && searchStart > 0) {
+            searchWrapped = true;
+            searchPosition = 0;
+            searchTimer.start();
+            return;
+        }
+        searchStatus = tr("\"%1\" was not found.").arg( QString::fromUtf8(searchText) );
+        updateStatus();
+        return;
+    }
+
+    const qint64 length = qMin(sliceSize + searchText.size() - 1, file.size() - searchPosition);
+    const char* data = reinterpret_cast<const char*>( file.map(searchPosition, length) );
+    if (data == 0) {
+        searchStatus = tr("The file could not be read: %1").arg( file.errorString() );
+        updateStatus();
+        return;
+    }
+
+    const QByteArray slice = QByteArray::fromRawData(data, int(length));
+    const int found = searchCaseSensitive ? slice.indexOf(searchText) : slice.toLower().indexOf(searchText);
+
+    if (found >= 0 && searchPosition + found < end) {
+        matchOffset = searchPosition + found;
+        searchStatus.clear();
+        topOffset = lineStartAt(matchOffset);
+        showWindow();
+
+        //Scintilla positions are byte offsets into the (UTF-8) text shown
+        const long start = long(matchOffset - topOffset);
+        view->SendScintilla(QsciScintillaBase::SCI_SETSEL, static_cast<unsigned long>(start), start + searchText.size());
+        updateStatus();
+        return;
+    }
+
+    searchPosition += sliceSize;
+    searchStatus = tr("Searching... %1%").arg( file.size() > 0 ? (searchWrapped ? file.size() - searchStart + searchPosition
+                                                                                : searchPosition - searchStart) * 100 / file.size() : 100 );
+    updateStatus();
+    searchTimer.start();
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+qint64 LargeFileViewer::findForward(qint64 from, qint64 to, char c) {
+/*  -returns the offset of the first `c` between the offsets `from` and `to` (excluded), or -1 if there is none */
+    to = qMin(to, file.size());
+    for (qint64 position = from; position < to; position += MappedFile::windowSize) {
+        const qint64 length = qMin(qint64(MappedFile::windowSize), to - position);
+        const char* data = reinterpret_cast<const char*>( file.map(position, length) );
+        if (data == 0) return -1;
+
+        const char* found = static_cast<const char*>( std::memchr(data, c, size_t(length)) );
+        if (found != 0) return position + (found - data);
+    }
+    return -1;
+}
+
+qint64 LargeFileViewer::findBackward(qint64 from, qint64 to, char c) {
+/*  -returns the offset of the last `c` before the offset `from` and not before the offset `to`, or -1 if there is none */
+    from = qMin(from, file.size());
+    for (qint64 position = from; position > to; ) {
+        const qint64 start = qMax(to, position - MappedFile::windowSize);
+        const char* data = reinterpret_cast<const char*>( file.map(start, position - start) );
+        if (data == 0) return -1;
+
+        for (const char* p = data + (position - start); p > data; ) {
+            if (*--p == c) return start + (p - data);
+        }
+        position = start;
+    }
+    return -1;
+}
+
+qint64 LargeFileViewer::countLineBreaks(qint64 from, qint64 to) {
+/*  -returns the number of line breaks between the offsets `from` and `to` (excluded) */
+    qint64 count = 0;
+    to = qMin(to, file.size());
+    for (qint64 position = from; position < to; position += MappedFile::windowSize) {
+        const qint64 length = qMin(qint64(MappedFile::windowSize), to - position);
+        const char* data = reinterpret_cast<const char*>( file.map(position, length) );
+        if (data == 0) break;
+
+        const char* end = data + length;
+        for (const char* p = data; p < end; p++) {
+            p = static_cast<const char*>( std::memchr(p, '\n', end - p) );
+            if (p == 0) break;
+            count++;
+        }
+    }
+    return count;
+}
+
+qint64 LargeFileViewer::lineStartAt(qint64 offset) {
+/*  -returns the offset of the start of the line containing `offset` */
+
+    //lines longer than `maxLineLength` are shown in segments, so the search for their start is bounded
+    const qint64 limit = qMax(qint64(0), offset - maxLineLength);
+    const qint64 lineBreak = findBackward(offset, limit, '\n');
+    return lineBreak >= 0 ? lineBreak + 1 : limit;
+}
+
+qint64 LargeFileViewer::nextLineStart(qint64 offset) {
+/*  -returns the offset of the start of the line after the one starting at `offset` (the end of the file if there is none) */
+    const qint64 limit = qMin(file.size(), offset + maxLineLength);
+    const qint64 lineBreak = findForward(offset, limit, '\n');
+    return lineBreak >= 0 ? lineBreak + 1 : limit;
+}
+
+qint64 LargeFileViewer::lineAt(qint64 offset) {
+/*  -returns the number of the line starting at `offset`, or -1 if it was not indexed yet */
+    if ( lineIndex.isEmpty() || (offset > indexedBytes && !indexComplete) ) return -1;
+
+    //the line is counted from the closest entry of the index before it
+    const int entry = int( std::upper_bound(lineIndex.constBegin(), lineIndex.constEnd(), offset) - lineIndex.constBegin() ) - 1;
+    return qint64(entry) * linesPerEntry + countLineBreaks(lineIndex.at(entry), offset);
+}
+
+qint64 LargeFileViewer::offsetOfLine(qint64 line) {
+/*  -returns the offset of the start of line `line` (the last line if there are fewer), or -1 if it was not indexed yet */
+    if ( lineIndex.isEmpty() ) return -1;
+    if (line > indexedLines) {
+        if (!indexComplete) return -1;
+        line = indexedLines;
+    }
+
+    const int entry = int( qMin(line / linesPerEntry, qint64( lineIndex.size() - 1 )) );
+    qint64 offset = lineIndex.at(entry);
+    for (qint64 i = qint64(entry) * linesPerEntry; i < line; i++) {
+        const qint64 lineBreak = findForward(offset, file.size(), '\n');
+        if (lineBreak < 0) break;
+        offset = lineBreak + 1;
+    }
+    return offset;
+}
+
+int LargeFileViewer::visibleLines() {
+/*  -returns the number of lines which fit in the view */
+    return qMax(1, int( view->SendScintilla(QsciScintillaBase::SCI_LINESONSCREEN) ));
+}
+
+void LargeFileViewer::scrollByLines(qint64 count) {
+/*  -scrolls down (or up, if `count` is negative) by `count` lines */
+    for (qint64 i = 0; i < count; i++) {
+        const qint64 next = nextLineStart(topOffset);
+        if ( next >= file.size() ) break;   //the last line stays on screen
+        topOffset = next;
+    }
+    for (qint64 i = 0; i > count && topOffset > 0; i--) topOffset = lineStartAt(topOffset - 1);
+    showWindow();
+}
+
+void LargeFileViewer::showWindow() {
+/*  -copies the lines starting at `topOffset` which fit in the view into it, and numbers them */
+
+    /*######################################################################################
+    ### Only the lines on screen (and one more, partially visible) are in the view's      ##
+    ### document, so the lexer only ever highlights those.  Constructs which start before ##
+    ### the first line shown (ex. a multi-line comment) are not known to it.              ##
+    ######################################################################################*/
+
+    qint64 windowEnd = topOffset;
+    for (int i = 0, lines = visibleLines() + 1; i < lines && windowEnd < file.size(); i++) windowEnd = nextLineStart(windowEnd);
+
+    view->setReadOnly(false);
+    view->SendScintilla(QsciScintillaBase::SCI_CLEARALL);
+    const char* text = windowEnd > topOffset ? reinterpret_cast<const char*>( file.map(topOffset, windowEnd - topOffset) ) : 0;
+    if (text != 0) view->SendScintilla(QsciScintillaBase::SCI_APPENDTEXT, static_cast<unsigned long>(windowEnd - topOffset), text);
+    view->setReadOnly(true);
+    view->SendScintilla(QsciScintillaBase::SCI_SETFIRSTVISIBLELINE, 0UL);
+
+    //number the lines shown (they are left blank until the index reaches them)
+    topLine = lineAt(topOffset);
+    view->clearMarginText();
+    if (topLine >= 0) {
+        const int lines = view->lines();
+        for (int i = 0; i < lines; i++) view->setMarginText(i, QString::number(topLine + i + 1), QsciScintillaBase::STYLE_LINENUMBER);
+        view->setMarginWidth(1, QString(QString::number(topLine + lines).length() + 1, QLatin1Char('9')));
+    }
+    else view->setMarginWidth(1, QString(8, QLatin1Char('9')));
+
+    updateScrollBar();
+}
+
+void LargeFileViewer::updateScrollBar() {
+/*  -moves the scroll bar to the part of the file shown */
+    const int range = int( qMin(qint64(scrollBarRange), file.size()) );
+    scrollBar->blockSignals(true);
+    scrollBar->setRange(0, range);
+    scrollBar->setPageStep( qMax(1, int( qint64(range) * visibleLines() * 80 / qMax(qint64(1), file.size()) )) );
+    scrollBar->setValue( file.size() > 0 ? int( topOffset * range / file.size() ) : 0 );
+    scrollBar->blockSignals(false);
+}
+
+void LargeFileViewer::updateStatus() {
+/*  -shows the progress of indexing and the result of the last search on the status line */
+    QLocale locale;
+    QString status;
+    if (indexComplete) status = tr("%1 lines (read-only)").arg( locale.toString(indexedLines + 1) );
+    else if (indexerThread != 0) status = tr("Indexing lines... %1% (read-only)").arg( file.size() > 0 ? indexedBytes * 100 / file.size() : 100 );
+    else status = tr("Lines could not be indexed (read-only)");
+
+    if (pendingLine >= 0) status += tr(" - line %1 is shown once it is indexed").arg( locale.toString(pendingLine + 1) );
+    if ( !searchStatus.isEmpty() ) status += " - " + searchStatus;
+    statusLabel->setText(status);
+}
+
+void LargeFileViewer::stopIndexer() {
+/*  -stops the thread indexing the lines and deletes the indexer */
+    if (indexer == 0) return;
+
+    disconnect(indexer, 0, this, 0);
+    indexer->cancel();
+    indexerThread->quit();
+    indexerThread->wait();
+
+    delete indexer;
+    delete indexerThread;
+    indexer = 0;
+    indexerThread = 0;
+}
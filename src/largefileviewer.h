@@ -0,0 +1,185 @@
+/*
+Project: Lepton Editor
+File: largefileviewer.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LargeFileViewer class.  It is a read-only view of
+    a text file too large to be loaded into an editor (ex. a log of tens of gigabytes).  The
+    file is mapped into memory a window at a time and only the lines on screen are copied into
+    a small Scintilla document, where they are highlighted.  The lines of the file are indexed
+    in the background so that any line can be gone to, and the file can be searched.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LARGEFILEVIEWER_H
+#define LARGEFILEVIEWER_H
+
+//include Qt classes
+#include <QWidget>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QThread>
+#include <QTimer>
+#include <QScrollBar>
+#include <QLabel>
+#include <QMenu>
+
+//include QScintilla classes
+#include <Qsci/qsciscintilla.h>
+
+//include Lepton files which are needed by this class
+#include "mappedfile.h"
+#include "lineindexer.h"
+#include "syntaxhighlightmanager.h"
+
+
+
+class LargeFileViewer : public QWidget {
+/*  -A read-only tab showing the lines of a (very large) text file a screenful at a time. */
+
+    Q_OBJECT
+    Q_PROPERTY(QString filePath READ getOpenFilePath)
+
+    public:
+        explicit LargeFileViewer(QWidget* parent = 0);
+        /*  -Class constructor */
+
+        ~LargeFileViewer();
+        /*  -Class destructor (stops indexing the file) */
+
+        bool openFile(const QString& filePath);
+        /*  -shows a file; returns false (after warning the user) if it can not be opened */
+
+        QString getOpenFilePath();
+        /*  -returns the path to the file being shown */
+
+        QMenu* getLanguageMenu();
+        /*  -returns the language selection menu */
+
+        void gotoLine(qint64 line);
+        /*  -shows the line `line` (counted from 0) at the top of the view, as soon as the index of the lines reaches it */
+
+        void find(const QString& text, bool caseSensitive);
+        /*  -searches the file for `text`, from the last match (or the top of the view) on, wrapping around at its end */
+
+        void findNext();
+        /*  -searches the file for the next match of the last text searched */
+
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event);
+        /*  -scrolls the file when the wheel is turned or the navigation keys are pressed over the view */
+
+        void resizeEvent(QResizeEvent* event);
+        /*  -shows as many lines as fit in the new size */
+
+    private slots:
+        void addIndexEntries(const QVector<qint64>& entries, qint64 lineCount, qint64 bytesIndexed);
+        /*  -adds entries found by the indexer to the index of the lines */
+
+        void indexingDone();
+        /*  -called when the whole file was indexed */
+
+        void scrollBarAction(int action);
+        /*  -scrolls by lines or by pages when the arrows of the scroll bar, or the bar itself, are clicked */
+
+        void scrollBarMoved(int value);
+        /*  -shows the part of the file the scroll bar was dragged to */
+
+        void continueSearch();
+        /*  -searches the next slice of the file for the text searched */
+
+    private:
+        static const int linesPerEntry = 1024;          //number of lines between entries of the index
+        static const qint64 maxLineLength = 1048576;    //longer lines are shown in segments of this length
+        static const int scrollBarRange = 1000000;      //number of steps of the scroll bar
+
+        MappedFile file;                //file being shown
+        QString filePath;               //path to the file being shown
+        QsciScintilla* view;            //editor showing the lines on screen
+        SyntaxHighlightManager* lexerManager;   //manager of the lexer highlighting the lines on screen
+        QScrollBar* scrollBar;          //scroll bar over the whole file
+        QLabel* statusLabel;            //shows the progress of indexing and searching
+        QThread* indexerThread;         //thread indexing the lines (null once they are indexed)
+        LineIndexer* indexer;           //object indexing the lines, on `indexerThread`
+        QVector<qint64> lineIndex;      //offset at which every `linesPerEntry`th line starts
+        qint64 indexedLines;            //number of line breaks indexed so far
+        qint64 indexedBytes;            //number of bytes indexed so far
+        bool indexComplete;             //true once the whole file was indexed
+        qint64 topOffset;               //offset of the first line shown
+        qint64 topLine;                 //number of the first line shown (-1 if it was not indexed yet)
+        qint64 pendingLine;             //line to go to once it is indexed (-1 if none)
+        QByteArray searchText;          //text searched (in lower case, if the search is not case sensitive)
+        bool searchCaseSensitive;       //true if the search is case sensitive
+        qint64 searchStart;             //offset the search started at
+        qint64 searchPosition;          //offset of the next slice of the file to search
+        bool searchWrapped;             //true once the search wrapped around to the start of the file
+        qint64 matchOffset;             //offset of the last match (-1 if none)
+        QTimer searchTimer;             //timer used to search the file a slice at a time
+        QString searchStatus;           //result of the last search (shown on the status line)
+
+        qint64 findForward(qint64 from, qint64 to, char c);
+        /*  -returns the offset of the first `c` between the offsets `from` and `to` (excluded), or -1 if there is none */
+
+        qint64 findBackward(qint64 from, qint64 to, char c);
+        /*  -returns the offset of the last `c` before the offset `from` and not before the offset `to`, or -1 if there is none */
+
+        qint64 countLineBreaks(qint64 from, qint64 to);
+        /*  -returns the number of line breaks between the offsets `from` and `to` (excluded) */
+
+        qint64 lineStartAt(qint64 offset);
+        /*  -returns the offset of the start of the line containing `offset` */
+
+        qint64 nextLineStart(qint64 offset);
+        /*  -returns the offset of the start of the line after the one starting at `offset` (the end of the file if there is none) */
+
+        qint64 lineAt(qint64 offset);
+        /*  -returns the number of the line starting at `offset`, or -1 if it was not indexed yet */
+
+        qint64 offsetOfLine(qint64 line);
+        /*  -returns the offset of the start of line `line` (the last line if there are fewer), or -1 if it was not indexed yet */
+
+        int visibleLines();
+        /*  -returns the number of lines which fit in the view */
+
+        void scrollByLines(qint64 count);
+        /*  -scrolls down (or up, if `count` is negative) by `count` lines */
+
+        void showWindow();
+        /*  -copies the lines starting at `topOffset` which fit in the view into it, and numbers them */
+
+        void updateScrollBar();
+        /*  -moves the scroll bar to the part of the file shown */
+
+        void updateStatus();
+        /*  -shows the progress of indexing and the result of the last search on the status line */
+
+        void stopIndexer();
+        /*  -stops the thread indexing the lines and deletes the indexer */
+};
+
+#endif // LARGEFILEVIEWER_H
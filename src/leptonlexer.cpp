@@ -39,10 +39,119 @@ Usage Agreement:
 
 //include other lepton objects
 #include "leptonconfig.h"
+#include "grammarregistry.h"
+#include "lexerprofiler.h"
 
 //include Qt classes
 #include <QFile>
 #include <QDomDocument>
+#include <QTimer>
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static void appendText(const QByteArray& bytes, int position, bool utf8, QString& text, QVector<int>& positions) {
+/*
+-decodes `bytes`, the editor text starting at `position`, and appends it to `text`
+-the position in the editor of every character appended is added to `positions`, followed by the
+ position after the last one (which replaces the one added by a previous call)
+-bytes which are not part of a valid UTF-8 character are decoded one at a time, as U+FFFD
+*/
+
+    /*#########################################################################################
+    ### In UTF-8 mode, Scintilla positions are byte offsets while the regular expressions   ##
+    ### are matched against UTF-16 text.  The text is decoded here, rather than with         ##
+    ### `QString::fromUtf8()`, so that the position of every character is known exactly,    ##
+    ### even when the document contains invalid UTF-8.  Characters outside the BMP take two ##
+    ### UTF-16 units: all of their bytes belong to the first one.                            ##
+    #########################################################################################*/
+
+    if ( ! positions.isEmpty() ) positions.removeLast();
+    text.reserve( text.length() + bytes.length() );
+    positions.reserve( positions.size() + bytes.length() + 1 );
+
+    for (int i = 0, length = bytes.length(); i < length; ) {
+        const uint lead = uchar( bytes.at(i) );
+        uint codePoint = lead;
+        int byteCount = 1;
+
+        if (utf8 && lead >= 0x80) {
+            if (lead >= 0xC2 && lead <= 0xDF) { byteCount = 2; codePoint = lead & 0x1F; }
+            else if (lead >= 0xE0 && lead <= 0xEF) { byteCount = 3; codePoint = lead & 0x0F; }
+            else if (lead >= 0xF0 && lead <= 0xF4) { byteCount = 4; codePoint = lead & 0x07; }
+            else byteCount = 0;
+
+            for (int j = 1; j < byteCount; j++) {
+                if ( i + j >= length || (uchar( bytes.at(i + j) ) & 0xC0) != 0x80 ) {
+                    byteCount = 0;
+                    break;
+                }
+                codePoint = (codePoint << 6) | (uchar( bytes.at(i + j) ) & 0x3F);
+            }
+
+            //overlong forms, surrogates and code points after U+10FFFF are not valid either
+            if ( (byteCount == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)))
+                 || (byteCount == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)) ) byteCount = 0;
+
+            if (byteCount == 0) {
+                byteCount = 1;
+                codePoint = 0xFFFD;
+            }
+        }
+
+        positions.append(position + i);
+        if (codePoint > 0xFFFF) {
+            text.append( QChar( QChar::highSurrogate(codePoint) ) );
+            text.append( QChar( QChar::lowSurrogate(codePoint) ) );
+            positions.append(position + i + byteCount);
+        }
+        else {
+            text.append( QChar(codePoint) );
+        }
+        i += byteCount;
+    }
+
+    positions.append( position + bytes.length() );
+}
+
+static const int textBlockSize = 16384;    //number of bytes read from the editor at a time while styling
+
+static int positionOf(const QVector<int>& positions, int index) {
+/*  -returns the position in the editor of the character at `index` of the text being styled (or of the end of the text) */
+    return positions.at( qBound(0, index, positions.size() - 1) );
+}
+
+struct RuleExpression {
+/* -An expression checked while tokenizing: the regular expression of a rule, with its native matcher if it has one. */
+    const QRegularExpression* expression;
+    NativeMatcher native;
+
+    RuleExpression(const QRegularExpression* e = 0, NativeMatcher n = 0) : expression(e), native(n) {}
+};
+
+static int matchRule(const RuleExpression& rule, const QString& text, bool partial, LexerProfiler::CallStatistics& profile) {
+/*
+-matches `rule` against the start of `text` and returns the length of the text matched, `NativeNoMatch`
+ or, only if `partial` is true, `NativePartialMatch` (its native matcher is used if it has one)
+-the result is recorded in `profile` when profiling is enabled
+*/
+    if (rule.native != 0) {
+        if ( LEXER_PROFILING_ENABLED() ) return LexerProfiler::profiledMatch(rule.expression, rule.native, text, profile, partial);
+        return rule.native(text.constData(), text.length(), partial);
+    }
+
+    QRegularExpression::MatchType matchType = partial ? QRegularExpression::PartialPreferFirstMatch : QRegularExpression::NormalMatch;
+    QRegularExpressionMatch match;
+    if ( LEXER_PROFILING_ENABLED() )
+        match = LexerProfiler::profiledMatch(rule.expression, text, profile, matchType);
+    else
+        match = rule.expression->match(text, 0, matchType);
+
+    if ( match.hasMatch() ) return match.capturedLength();
+    if ( match.hasPartialMatch() ) return NativePartialMatch;
+    return NativeNoMatch;
+}
 
 
 
@@ -53,18 +162,32 @@ LeptonLexer::LeptonLexer(QsciScintilla* parent) : QsciLexerCustom( (QObject*)par
 
     languageName.clear();
 
+    //get the limits used to style very long lines (minified files, data dumps, etc.)
+    longLineThreshold = LeptonConfig::mainSettings->getValueOrDefault(10000, "large_files", "long_line_threshold").toInt();
+    longLineWindow = LeptonConfig::mainSettings->getValueOrDefault(4096, "large_files", "long_line_lexer_window").toInt();
+    if (longLineWindow < 256) longLineWindow = 256;
+    pendingStyleEnd = 0;
+    continuationPending = false;
+    stylingEnabled = true;
+
     loadStyle( LeptonConfig::mainSettings->getStyleFilePath("default.xml") );
 
-    rootRule.subRules.clear();
+    rootRule = QSharedPointer<const TokenRule>(new TokenRule);
 
     TokenRuleStack ruleListStack;
-    ruleListStack.push(&rootRule);
+    ruleListStack.push( rootRule.data() );
     stackAtPosition.append(ruleListStack);
 
     loadLanguage();
     setAutoIndentStyle(QsciScintilla::AiMaintain);
 }
 
+LeptonLexer::~LeptonLexer() {
+    stackAtPosition.clear();    //the saved stacks point into the rules of the language
+    rootRule.clear();
+    GrammarRegistry::languageReleased();
+}
+
 const char* LeptonLexer::language() const {
 /*
 -returnes language name
@@ -92,14 +215,46 @@ void LeptonLexer::styleText(int start, int end) {
     ###         and go back to (1)                                                ##
     ##############################################################################*/
 
-    const QString& editorText = editor()->text();
-    if ( editorText.isEmpty() ) return;
+    if ( ! stylingEnabled ) return;     //another view of the document styles it (Scintilla then asks that view's lexer)
 
-    if ( rootRule.subRules.isEmpty() ) {
-        applyStyleTo(0, editorText.length() ,0);
+    const int documentLength = editor()->length();
+    if ( documentLength == 0 ) return;
+
+    if ( rootRule->subRules.isEmpty() ) {
+        applyStyleTo(start, end - start, 0);
         return;
     }
 
+    /*##################################################################################################
+    ### Scintilla always requests styling from the start of the line containing the first unstyled    ##
+    ### character.  For a line that is several megabytes long (minified code, JSON dumps, etc.), this ##
+    ### means re-tokenizing the entire line every time a few more characters need to be styled.  So,  ##
+    ### for lines longer than `longLineThreshold`, resume from the last styled position and only      ##
+    ### style a bounded window of text.  Only that window (plus some look-ahead) is read from the     ##
+    ### editor and the rest of the requested range is styled later by `continueStyling()`.           ##
+    ##################################################################################################*/
+
+    const int requestedEnd = end;
+    const long line = editor()->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, start);
+    const bool windowed = longLineThreshold > 0 && editor()->SendScintilla(QsciScintillaBase::SCI_LINELENGTH, line) > longLineThreshold;
+
+    if (windowed) {
+        int endStyled = editor()->SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+        if (endStyled > start && endStyled < end && endStyled < stackAtPosition.size()) start = endStyled;
+        if (end - start > longLineWindow) end = start + longLineWindow;
+    }
+
+    /*###########################################################################################
+    ### The text is read from the editor a block at a time, starting at `start`, as the        ##
+    ### tokenizer reaches it: tokenizing usually stops shortly after `end`, but it goes on for ##
+    ### as long as the rule stacks differ from the saved ones (ex. after a span was opened).   ##
+    ### No copy of the text is kept once styling is done.                                      ##
+    ###########################################################################################*/
+
+    QString editorText;                             //the text being tokenized
+    QVector<int> textPositions(1, start);           //position in the editor of every character in `editorText` (and of its end)
+    const int textLimit = windowed ? qMin(documentLength, end + longLineWindow) : documentLength;  //position up to which text may be read
+
     TokenRuleStack ruleListStack;   //a stack to keep track of the current token rule list being checked
 
     /*##############################################################################################
@@ -113,22 +268,29 @@ void LeptonLexer::styleText(int start, int end) {
     else
         ruleListStack = stackAtPosition.at(start);
 
-    if (editorText.size() > 1) stackAtPosition.resize( editorText.size() ); //resize the stack list to fit all characters in the text
+    if (documentLength > 1) stackAtPosition.resize(documentLength);    //resize the stack list to fit all positions in the text
 
     QString buffer;             //buffer used to store the string being compared against rule expressions
-    int charPosition = start;   //variable to store the position (in the editor text string) of the last character to be added to the buffer
+    LexerProfiler::CallStatistics profile;  //statistics about the rules checked (only collected when profiling)
+    int charIndex = 0;          //variable to store the index (in `editorText`) of the last character to be added to the buffer
 
     //tokenize the text by iteratively traversing it
     while (1) {
         if (ruleListStack.isEmpty()) break;             //%%%% this is required to prevent seg-faults when scrolling through a file %%%%
-        TokenRule currentRoot = *(ruleListStack.top()); //get the current rule list
+        const TokenRule* currentRoot = ruleListStack.top(); //get the current rule list
 
-        //create a list of rules
-        QList<const QRegularExpression* > expList;
-        for (int i = 0, c = currentRoot.subRules.length(); i < c; i++) {
-            expList.append( &(currentRoot.subRules.at(i).rule) );
+        //create a list of rules (the rules of an included language come after the span's own rules)
+        QList<RuleExpression> expList;
+        for (int i = 0, c = currentRoot->subRules.length(); i < c; i++) {
+            expList.append( RuleExpression(&(currentRoot->subRules.at(i).rule), currentRoot->subRules.at(i).nativeRule) );
         }
-        if (ruleListStack.size() > 1) expList.append(&(currentRoot.closeRule));
+        if ( ! currentRoot->include.isNull() ) {
+            const TokenRuleList& includedRules = currentRoot->include->subRules;
+            for (int i = 0, c = includedRules.length(); i < c; i++) {
+                expList.append( RuleExpression(&(includedRules.at(i).rule), includedRules.at(i).nativeRule) );
+            }
+        }
+        if (ruleListStack.size() > 1) expList.append( RuleExpression(&(currentRoot->closeRule), currentRoot->nativeCloseRule) );
 
         int extraCharCount = 0; //variable to store the number of character appended to the buffer that are not part of the text
 
@@ -144,9 +306,17 @@ void LeptonLexer::styleText(int start, int end) {
         while (1) {
             int matchCount = 0;
 
-            if ( charPosition < editorText.length() ) {
-                buffer.append( editorText.at(charPosition) );
-                stackAtPosition[charPosition] = ruleListStack;  //save the current stack to the list for reference on latter calls to this method
+            if ( readCharacter(charIndex, textLimit, editorText, textPositions) ) {
+                buffer.append( editorText.at(charIndex) );
+
+                //save the current stack to the list (for every byte of the character) for reference on latter calls to this method
+                for (int p = textPositions.at(charIndex), next = textPositions.at(charIndex + 1); p < next; p++) stackAtPosition[p] = ruleListStack;
+
+                //a character outside the BMP is added whole: regular expressions do not match half of one
+                if ( editorText.at(charIndex).isHighSurrogate() && readCharacter(charIndex + 1, textLimit, editorText, textPositions) && editorText.at(charIndex + 1).isLowSurrogate() ) {
+                    charIndex++;
+                    buffer.append( editorText.at(charIndex) );
+                }
             }
             else {
                 buffer.append(" ");
@@ -155,10 +325,11 @@ void LeptonLexer::styleText(int start, int end) {
 
             //check every rule in the list for a token match
             for (int i = expList.length() - 1; i >= 0; i--) {
-                QRegularExpressionMatch match = expList.at(i)->match(buffer, 0, QRegularExpression::PartialPreferFirstMatch);
-                if ( match.hasMatch() )
+                int matchLength = matchRule(expList.at(i), buffer, true, profile);
+
+                if ( matchLength >= 0 )
                     matchCount++;
-                else if ( match.hasPartialMatch() )
+                else if ( matchLength == NativePartialMatch )
                     continue;
                 else {
                     expList.removeAt(i);
@@ -178,12 +349,13 @@ void LeptonLexer::styleText(int start, int end) {
                 ################################################################################*/
 
                 if(matchCount == 0) {
-                    applyStyleTo(charPosition - buffer.length() + 1, buffer.length() - extraCharCount, 0);
-                    charPosition++;
+                    styleCharacters(textPositions, charIndex - buffer.length() + 1, buffer.length() - extraCharCount, 0);
+                    charIndex++;
                 }
 
                 else if (matchCount >= 1) {
-                    QRegularExpressionMatch match = currentRoot.closeRule.match(buffer);
+                    int matchLength = NativeNoMatch;
+                    if ( ruleListStack.size() > 1 ) matchLength = matchRule(RuleExpression(&(currentRoot->closeRule), currentRoot->nativeCloseRule), buffer, false, profile);
 
                     /*#####################################################################################
                     ### If one or more rules were matched, start by checking if the rule is the closing  ##
@@ -193,65 +365,102 @@ void LeptonLexer::styleText(int start, int end) {
                     ### of token, highlight the matched text and put the token's sub rules on the stack  ##
                     #####################################################################################*/
 
-                    if ( ruleListStack.size() > 1 && match.hasMatch() ) {
-                        applyStyleTo(charPosition - buffer.length() + 1, match.capturedLength(), currentRoot.id);
+                    if ( ruleListStack.size() > 1 && matchLength >= 0 ) {
+                        styleCharacters(textPositions, charIndex - buffer.length() + 1, matchLength, currentRoot->id);
                         ruleListStack.pop();
-                        currentRoot = *(ruleListStack.top());
+                        currentRoot = ruleListStack.top();
                     }
                     else {
-                        match = expList.at(0)->match(buffer);
+                        matchLength = qMax( 0, matchRule(expList.at(0), buffer, false, profile) );
                         const TokenRule* r;
 
-                        for (int i = 0, l = currentRoot.subRules.length(); i < l; i++) {
-                            if ( expList.at(0) == &(currentRoot.subRules.at(i).rule ) ) r = &(currentRoot.subRules.at(i));
+                        for (int i = 0, l = currentRoot->subRules.length(); i < l; i++) {
+                            if ( expList.at(0).expression == &(currentRoot->subRules.at(i).rule ) ) r = &(currentRoot->subRules.at(i));
+                        }
+                        if ( ! currentRoot->include.isNull() ) {
+                            const TokenRuleList& includedRules = currentRoot->include->subRules;
+                            for (int i = 0, l = includedRules.length(); i < l; i++) {
+                                if ( expList.at(0).expression == &(includedRules.at(i).rule ) ) r = &(includedRules.at(i));
+                            }
                         }
 
-                        applyStyleTo(charPosition - buffer.length() + 1, match.capturedLength(), r->id);
+                        styleCharacters(textPositions, charIndex - buffer.length() + 1, matchLength, r->id);
 
-                        if ( ! r->subRules.isEmpty() ) {
+                        if ( ! r->subRules.isEmpty() || ! r->include.isNull() ) {
                             ruleListStack.push(r);
-                            currentRoot = *r;
+                            currentRoot = r;
                         }
                     }
 
                     /*###########################################################################################
-                    ### As a rule (to prevent some serious bugs), after having matched a token, `charPosition` ##
+                    ### As a rule (to prevent some serious bugs), after having matched a token, `charIndex`    ##
                     ### should always reference the character IMMEDIATLY after the last character of the text  ##
                     ### matched (a.k.a. the character after the last character of the lexeme).                 ##
                     ###########################################################################################*/
 
-                    if (match.capturedLength() >= buffer.length()){
-                        charPosition += match.capturedLength() - buffer.length() + 1;
+                    if (matchLength >= buffer.length()){
+                        charIndex += matchLength - buffer.length() + 1;
                     }
-                    else if ( match.capturedLength() + 1 < buffer.length() ) {
-                        charPosition -= buffer.length() - match.capturedLength() - 1;
+                    else if ( matchLength + 1 < buffer.length() ) {
+                        charIndex -= buffer.length() - matchLength - 1;
                     }
                 }
 
                 break;
             }
-            else if ( charPosition > end ) {
+            else if ( positionOf(textPositions, charIndex) > end ) {
+                if (windowed) {             //finish the current token, as long as there is look-ahead text left
+                    if ( readCharacter(charIndex + 1, textLimit, editorText, textPositions) ) charIndex++;
+                    else break;
+                    continue;
+                }
+
                 //%%% this is messy but it works %%%%
-                if ( charPosition + 1 < editorText.length() ) {
-                    if (stackAtPosition.at(charPosition + 1) != ruleListStack) charPosition++;
+                if ( readCharacter(charIndex + 1, textLimit, editorText, textPositions) ) {
+                    if (stackAtPosition.at( textPositions.at(charIndex + 1) ) != ruleListStack) charIndex++;
                     else break;
                 }
                 else break;
             }
             else if ( matchCount < expList.length() ) {
-                charPosition++;
+                charIndex++;
             }
         }
 
-        if ( charPosition >= end ) {
+        if ( positionOf(textPositions, charIndex) >= end ) {
+            if (windowed) break;
+
             //%%% this is even messier but still works %%%%
-            if ( charPosition + 1 < editorText.length() ) {
-                if (stackAtPosition.at(charPosition + 1) != ruleListStack) /*do nothing*/;
+            if ( readCharacter(charIndex + 1, textLimit, editorText, textPositions) ) {
+                if (stackAtPosition.at( textPositions.at(charIndex + 1) ) != ruleListStack) /*do nothing*/;
                 else break;
             }
             else break;
         }
     }
+
+    if ( LEXER_PROFILING_ENABLED() && ! profile.isEmpty() ) LexerProfiler::addStatistics(rootRule.data(), profile);
+
+    /*#############################################################################################
+    ### When only a window of a long line was styled, remember the rule stack at the position    ##
+    ### where tokenization stopped so the next window can resume from there, and schedule the    ##
+    ### rest of the requested range to be styled once control returns to the event loop.  This  ##
+    ### keeps the editor responsive while the line is being styled.                              ##
+    #############################################################################################*/
+
+    if (windowed) {
+        int stopPosition = positionOf(textPositions, charIndex);
+        if (stopPosition < stackAtPosition.size()) stackAtPosition[stopPosition] = ruleListStack;
+
+        bool madeProgress = editor()->SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED) > start;
+        if (end < requestedEnd && madeProgress) {
+            pendingStyleEnd = qMax(pendingStyleEnd, requestedEnd);
+            if (!continuationPending) {
+                continuationPending = true;
+                QTimer::singleShot(0, this, SLOT(continueStyling()));
+            }
+        }
+    }
 }
 
 void LeptonLexer::applyStyleTo(int start, int length, int style) {
@@ -260,6 +469,55 @@ void LeptonLexer::applyStyleTo(int start, int length, int style) {
     setStyling(length, style);
 }
 
+void LeptonLexer::styleCharacters(const QVector<int>& positions, int first, int count, int style) {
+/*
+-applies `style` to `count` characters of the text being styled, starting with the character at index `first`
+-`positions` holds the position in the editor of every character of the text (and of its end)
+*/
+    int startPosition = positionOf(positions, first);
+    applyStyleTo(startPosition, positionOf(positions, first + count) - startPosition, style);
+}
+
+void LeptonLexer::setLongLineThreshold(int threshold) {
+/*  -sets the length above which lines are styled in bounded windows (0 disables windowed styling) */
+    longLineThreshold = threshold;
+}
+
+void LeptonLexer::setStylingEnabled(bool enabled) {
+/*  -sets whether the lexer styles the text of its editor (it does not when the document is styled by the lexer of another view of it) */
+    stylingEnabled = enabled;
+    pendingStyleEnd = 0;
+    resetRuleStacks();  //the saved stacks are not kept up to date while another lexer styles the text
+}
+
+void LeptonLexer::resetRuleStacks() {
+/*
+-forgets the token rule stack used at every position of the text so that it can be
+ tokenized again (ex. after the tokenization rules change)
+*/
+
+    /*########################################################################################
+    ### The stacks saved for the previous rules may point to rules that no longer exist.    ##
+    ### Replacing all of them with the root rule list means that tokenization can start     ##
+    ### anywhere in the text, without having to start over from the beginning of the text. ##
+    ########################################################################################*/
+
+    TokenRuleStack rootStack;
+    rootStack.push( rootRule.data() );
+
+    if ( stackAtPosition.isEmpty() ) stackAtPosition.append(rootStack);
+    else stackAtPosition.fill(rootStack);
+}
+
+void LeptonLexer::discardRuleStacksBefore(int position) {
+/*  -forgets the token rule stacks used before `position`, once the text before it was removed from the start of the document */
+    if ( position <= 0 || stackAtPosition.isEmpty() ) return;
+
+    //the stacks of the text which is left move with it, so that text does not have to be tokenized again
+    if ( position < stackAtPosition.size() ) stackAtPosition.remove(0, position);
+    else stackAtPosition = QVector<TokenRuleStack>(1, stackAtPosition.last());
+}
+
 
 
 //~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -269,69 +527,23 @@ bool LeptonLexer::loadLanguage(const QString& filePath) {
 -loads language tokenization rules from file
 -returns true if the data was successfully extracted, false otherwise
 */
-    if ( filePath.isEmpty() ){  //if no language file path is specified
-        rootRule.subRules.clear();  //clear all rules and return
-        return true;
-    }
-
-    //create a file object to load the language tokenization rules (stored in xml)
-    QFile languageFile(filePath);
-    QDomDocument langDoc("language_document");
-
-    if (! langDoc.setContent(&languageFile) ) return false;
+    QSharedPointer<const TokenRule> newRoot;
 
-    //get the documents root element
-    QDomElement rootElement = langDoc.documentElement();
-    if ( rootElement.nodeName() != "language" ) return false;
-
-    /*###########################################################################################
-    ### Note: When the following line recursively calls this method and passes an empty string ##
-    ### (`use` attribute not present), this will cause the current rules to be cleared, which  ##
-    ### is exactly what we want.  However, if language files link to eachother in a loop       ##
-    ### (which doesn't make any practical sense), a stack overflow will occure.                ##
-    ###########################################################################################*/
-    bool r = loadLanguage( LeptonConfig::mainSettings->getLangFilePath( rootElement.attribute("use", QString() ) ) );
-    if (r == false) return false;
-
-    //get the name of the language (displayed in menu)
-    if ( !rootElement.hasAttribute("name") || rootElement.attribute("name").isEmpty() ) return false;
-    languageName = rootElement.attribute("name").toUtf8();
-
-    //get the element that containes all tokenization rule definitions
-    if ( rootElement.lastChildElement("tokenization").isNull() ) return false;
-    QDomElement tokenizationRules = rootElement.lastChildElement("tokenization");
-
-    //check if any keywords are defined and, if so, extract them
-    QDomNodeList ruleElements = tokenizationRules.elementsByTagName("keywords");
-    for (int i = 0, count = ruleElements.count(); i < count; i++) {
-        QDomElement rule = ruleElements.at(i).toElement();
-        int ruleClass = rule.attribute("class").toInt();
-        if (ruleClass < 0 || ruleClass > 31 ) continue;
-        TokenRule newRule;
-        newRule.name = "KEYWORD";
-        newRule.id = ruleClass;
-        QString exp = rule.firstChild().nodeValue().simplified().replace( QRegularExpression("\\s"), "|").prepend("^\\b(").append(")\\b");
-        newRule.rule.setPattern(exp);
-        if ( ! newRule.rule.isValid() ) continue;
-        rootRule.subRules.append(newRule);
+    if ( filePath.isEmpty() ) {     //if no language file path is specified, clear all rules
+        if ( rootRule->subRules.isEmpty() ) return true;
+        newRoot = QSharedPointer<const TokenRule>(new TokenRule);
     }
-
-    //check if numbers are used and, if so, implement them
-    if (! tokenizationRules.lastChildElement("numbers").isNull() ) {
-        int ruleClass = tokenizationRules.lastChildElement("numbers").attribute("class").toInt();
-        if ( ruleClass >= 0 && ruleClass <= 31) {
-            TokenRule newRule;
-            newRule.name = "NUMBER";
-            newRule.id = ruleClass;
-            QString exp = "^(\\b\\d+\\b)";
-            newRule.rule.setPattern(exp);
-            if ( newRule.rule.isValid() ) rootRule.subRules.append(newRule);
-        }
+    else {
+        //the rules are compiled (and shared with other lexers) by the grammar registry
+        newRoot = GrammarRegistry::getRegistry()->language(filePath);
+        if ( newRoot.isNull() ) return false;
+        languageName = newRoot->name.toUtf8();
+        if (newRoot == rootRule) return true;
     }
 
-    //extract all other tokenization rules defined purly using regular expressions
-    r = extractRulesFrom(tokenizationRules, rootRule.subRules);
-    if (r == false) return false;
+    rootRule = newRoot;
+    resetRuleStacks();  //the saved stacks refer to the rules of the previous language
+    GrammarRegistry::languageReleased();
 
     return true;
 }
@@ -380,13 +592,56 @@ bool LeptonLexer::loadStyle(const QString& filePath) {
         }
     }
 
+    emit stylesLoaded();
+
     return true;
 }
 
 
 
+//~private slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void LeptonLexer::continueStyling() {
+/*  -styles the next window of a long line which was cut short by `styleText()` */
+    continuationPending = false;
+    if (editor() == 0) return;
+
+    int endStyled = editor()->SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+    int styleEnd = qMin(pendingStyleEnd, editor()->length());
+    if (endStyled < styleEnd)
+        editor()->SendScintilla(QsciScintillaBase::SCI_COLOURISE, endStyled, styleEnd);    //will call `styleText()` with the next window
+    else
+        pendingStyleEnd = 0;
+}
+
+
+
 //~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+bool LeptonLexer::readCharacter(int index, int limit, QString& text, QVector<int>& positions) {
+/*
+-makes sure that the character at `index` of the text being styled was read from the editor, reading
+ the next block of text (but nothing after position `limit`) if it was not
+-`positions` holds the position in the editor of every character of the text (and of its end)
+-returns false if the text ends before `index`
+*/
+    while ( index >= text.length() ) {
+        const int position = positions.last();
+        if (position >= limit) return false;
+
+        //blocks get larger as more text is needed, and never end in the middle of a character
+        int blockEnd = qMin( limit, position + qMax(textBlockSize, text.length()) );
+        if ( blockEnd < editor()->length() )
+            blockEnd = editor()->SendScintilla( QsciScintillaBase::SCI_POSITIONAFTER, editor()->SendScintilla(QsciScintillaBase::SCI_POSITIONBEFORE, blockEnd) );
+
+        QByteArray block(blockEnd - position + 1, '\0');
+        editor()->SendScintilla(QsciScintillaBase::SCI_GETTEXTRANGE, position, blockEnd, block.data());
+        block.chop(1);
+        appendText(block, position, editor()->isUtf8(), text, positions);
+    }
+    return true;
+}
+
 bool LeptonLexer::setDefaultStyleValues() {
 /* -gets the default style values */
     setDefaultPaper( LeptonConfig::mainSettings->getDefaultPaper() );
@@ -397,44 +652,3 @@ bool LeptonLexer::setDefaultStyleValues() {
     setFont( LeptonConfig::mainSettings->getDefaultEditorFont(), 0);
     return true;
 }
-
-bool LeptonLexer::extractRulesFrom(const QDomElement& tokenizationRules, TokenRuleList& rList) {
-/*
--extracts all tokenization rules from `rule` and `spanrule` elements in `tokenizationRules`
- and adds them to rList
-*/
-
-    QDomNodeList nodes = tokenizationRules.childNodes();
-    for (int i = 0, count = nodes.count(); i < count; i++) {
-        if ( nodes.at(i).isElement() ) {
-            QDomElement ruleElement = nodes.at(i).toElement();
-            if (ruleElement.tagName() == "rule") {
-                int ruleClass = ruleElement.attribute("class").toInt();
-                if (ruleClass < 0 || ruleClass > 31 ) continue;
-                TokenRule newRule;
-                newRule.name = ruleElement.attribute("name");
-                newRule.id = ruleClass;
-                QString exp = ruleElement.firstChild().nodeValue().prepend("^(").append(")");
-                newRule.rule.setPattern(exp);
-                if ( ! newRule.rule.isValid() ) continue;
-                rList.append(newRule);
-            }
-            else if (ruleElement.tagName() == "spanrule") {
-                int ruleClass = ruleElement.attribute("class").toInt();
-                if (ruleClass < 0 || ruleClass > 31 ) continue;
-                TokenRule newRule;
-                newRule.name = ruleElement.attribute("name");
-                newRule.id = ruleClass;
-                QString exp = ruleElement.lastChildElement("open").firstChild().nodeValue().prepend("^(").append(")");
-                newRule.rule.setPattern(exp);
-                exp = ruleElement.lastChildElement("close").firstChild().nodeValue().prepend("^(").append(")");
-                newRule.closeRule.setPattern(exp);
-                if ( ! newRule.rule.isValid() || ! newRule.closeRule.isValid() ) continue;
-                extractRulesFrom(ruleElement, newRule.subRules);
-                rList.append(newRule);
-            }
-        }
-    }
-
-    return true;
-}
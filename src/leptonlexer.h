@@ -53,6 +53,10 @@ Usage Agreement:
 #include <QDomElement>
 #include <QStack>
 #include <QVector>
+#include <QSharedPointer>
+
+//include other Lepton files needed by this class
+#include "builtinlanguages.h"
 
 
 
@@ -70,8 +74,11 @@ class TokenRule {
         QRegularExpression rule;
         TokenRuleList subRules;
         QRegularExpression closeRule;
+        QSharedPointer<const TokenRule> include;    //root rule of a language whose rules are also used inside this span (null if none)
+        NativeMatcher nativeRule;                   //matcher generated for `rule` if the language is built into Lepton (0 if none)
+        NativeMatcher nativeCloseRule;              //matcher generated for `closeRule` if the language is built into Lepton (0 if none)
 
-        TokenRule() : subRules( TokenRuleList() ), id(0) {}
+        TokenRule() : subRules( TokenRuleList() ), id(0), nativeRule(0), nativeCloseRule(0) {}
         ~TokenRule() {}
 };
 
@@ -103,6 +110,8 @@ class LeptonLexer : public QsciLexerCustom {
     public:
         explicit LeptonLexer(QsciScintilla* parent = 0);
 
+        virtual ~LeptonLexer();
+
         const char* language() const;
         /*
         -returnes language name
@@ -118,6 +127,27 @@ class LeptonLexer : public QsciLexerCustom {
         void applyStyleTo(int start, int length, int style);
         /* -applies 'style' between positions 'start' and 'end' inclusively */
 
+        void styleCharacters(const QVector<int>& positions, int first, int count, int style);
+        /*
+            -applies `style` to `count` characters of the text being styled, starting with the character at index `first`
+            -`positions` holds the position in the editor of every character of the text (and of its end)
+        */
+
+        void setLongLineThreshold(int threshold);
+        /*  -sets the length above which lines are styled in bounded windows (0 disables windowed styling) */
+
+        void setStylingEnabled(bool enabled);
+        /*  -sets whether the lexer styles the text of its editor (it does not when the document is styled by the lexer of another view of it) */
+
+        void resetRuleStacks();
+        /*
+            -forgets the token rule stack used at every position of the text so that it can be
+             tokenized again (ex. after the tokenization rules change)
+        */
+
+        void discardRuleStacksBefore(int position);
+        /*  -forgets the token rule stacks used before `position`, once the text before it was removed from the start of the document */
+
     public slots:
 
         bool loadLanguage(const QString& filePath = 0);
@@ -131,17 +161,34 @@ class LeptonLexer : public QsciLexerCustom {
             -returns true if successful, otherwise false
         */
 
+    signals:
+        void stylesLoaded();
+        /*  -emitted when styling data was loaded from a file (the colors and fonts of the style classes changed) */
+
+    private slots:
+        void continueStyling();
+        /*  -styles the next window of a long line which was cut short by `styleText()` */
+
     private:
         QByteArray languageName;    //name of language used for syntax highlighting
-        TokenRule rootRule;         //a root node to hold the main tokenization rules
+        QSharedPointer<const TokenRule> rootRule;   //a root node to hold the main tokenization rules (shared with other lexers)
         QVector<TokenRuleStack> stackAtPosition;  //a list to look up the token rule stack at any given position
+        int longLineThreshold;      //lines longer than this are styled in bounded windows
+        int longLineWindow;         //maximum number of characters of a long line styled in one call to `styleText()`
+        int pendingStyleEnd;        //position up to which styling of a long line was requested but not yet done
+        bool continuationPending;   //true if a call to `continueStyling()` is already scheduled
+        bool stylingEnabled;        //false if the document is shared with another editor, whose lexer styles it
+
+        bool readCharacter(int index, int limit, QString& text, QVector<int>& positions);
+        /*
+            -makes sure that the character at `index` of the text being styled was read from the editor, reading
+             the next block of text (but nothing after position `limit`) if it was not
+            -`positions` holds the position in the editor of every character of the text (and of its end)
+            -returns false if the text ends before `index`
+        */
 
         bool setDefaultStyleValues();
         /* -gets the default style values */
-
-        bool extractRulesFrom(const QDomElement& tokenizationElement, TokenRuleList& rList);
-        /*  -extracts all tokenization rules from `rule` and `spanrule` elements in `tokenizationElement`
-             and adds them to rList */
 };
 
 #endif // LEPTONLEXER_H
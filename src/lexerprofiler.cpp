@@ -0,0 +1,189 @@
+/*
+Project: Lepton Editor
+File: lexerprofiler.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LexerProfiler class.  When profiling is
+    enabled, `LeptonLexer` records how many times each token rule was tried, how many times
+    it matched (fully or partially) and how much time was spent matching it.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "lexerprofiler.h"
+
+//include Qt classes
+#include <QElapsedTimer>
+#include <QSet>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+
+
+//~static data~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+bool LexerProfiler::enabled = false;
+QHash<QString, LexerProfiler::RuleStatistics> LexerProfiler::ruleStatistics;
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static void findRulesIn(const TokenRule* rule, const QString& language, QHash<const QRegularExpression*, LexerProfiler::RuleStatistics>& rules, QSet<const TokenRule*>& visitedLanguages) {
+/*
+-adds an entry, identifying the rule it belongs to, for the expressions of every rule under `rule`
+ (including the rules of the languages it includes) to `rules`
+*/
+    for (int i = 0, c = rule->subRules.length(); i < c; i++) {
+        const TokenRule& subRule = rule->subRules.at(i);
+
+        LexerProfiler::RuleStatistics entry;
+        entry.language = language;
+        entry.name = subRule.name;
+        entry.id = subRule.id;
+        rules.insert(&subRule.rule, entry);
+
+        if ( ! subRule.subRules.isEmpty() || ! subRule.include.isNull() ) {
+            entry.name = subRule.name + " (close)";     //the closing expression of a span is reported separately
+            rules.insert(&subRule.closeRule, entry);
+            findRulesIn(&subRule, language, rules, visitedLanguages);
+        }
+    }
+
+    if ( ! rule->include.isNull() && ! visitedLanguages.contains( rule->include.data() ) ) {
+        visitedLanguages.insert( rule->include.data() );
+        findRulesIn(rule->include.data(), rule->include->name, rules, visitedLanguages);
+    }
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+QRegularExpressionMatch LexerProfiler::profiledMatch(const QRegularExpression* expression, const QString& text, CallStatistics& callStatistics,
+                                                     QRegularExpression::MatchType matchType) {
+/*  -matches `expression` against `text` (allowing partial matches, by default) and records the result in `callStatistics` */
+    QElapsedTimer timer;
+    timer.start();
+    QRegularExpressionMatch match = expression->match(text, 0, matchType);
+    qint64 elapsed = timer.nsecsElapsed();
+
+    RuleStatistics& entry = callStatistics[expression];
+    entry.attempts++;
+    entry.nanoseconds += elapsed;
+    if ( match.hasMatch() ) entry.matches++;
+    else if ( match.hasPartialMatch() ) entry.partialMatches++;
+
+    return match;
+}
+
+int LexerProfiler::profiledMatch(const QRegularExpression* expression, NativeMatcher native, const QString& text, CallStatistics& callStatistics, bool partial) {
+/*
+-matches `native`, the native matcher of `expression`, against `text` and records the result in
+ `callStatistics` as a result of `expression`
+-returns the result of `native`
+*/
+    QElapsedTimer timer;
+    timer.start();
+    int matchLength = native(text.constData(), text.length(), partial);
+    qint64 elapsed = timer.nsecsElapsed();
+
+    RuleStatistics& entry = callStatistics[expression];
+    entry.attempts++;
+    entry.nanoseconds += elapsed;
+    if (matchLength >= 0) entry.matches++;
+    else if (matchLength == NativePartialMatch) entry.partialMatches++;
+
+    return matchLength;
+}
+
+void LexerProfiler::addStatistics(const TokenRule* root, const CallStatistics& callStatistics) {
+/*
+-adds the statistics collected during one call to `LeptonLexer::styleText()` to the
+ statistics of the rules of the language whose root rule is `root`
+*/
+
+    /*########################################################################################
+    ### While tokenizing, the lexer only knows which expression was checked, so statistics  ##
+    ### are collected per expression and only attributed to the rules (by language, name   ##
+    ### and class) once per call.  Rules are identified by name rather than by address so   ##
+    ### that statistics are kept when a language is reloaded.                               ##
+    ########################################################################################*/
+
+    QHash<const QRegularExpression*, RuleStatistics> rules;
+    QSet<const TokenRule*> visitedLanguages;
+    findRulesIn(root, root->name, rules, visitedLanguages);
+
+    for (CallStatistics::const_iterator i = callStatistics.constBegin(); i != callStatistics.constEnd(); ++i) {
+        if ( ! rules.contains( i.key() ) ) continue;
+        const RuleStatistics& rule = rules[ i.key() ];
+
+        QString key = QString("%1\n%2\n%3").arg(rule.language, rule.name).arg(rule.id);
+        RuleStatistics& entry = ruleStatistics[key];
+        if (entry.attempts == 0) {
+            entry.language = rule.language;
+            entry.name = rule.name;
+            entry.id = rule.id;
+        }
+        entry.attempts += i.value().attempts;
+        entry.matches += i.value().matches;
+        entry.partialMatches += i.value().partialMatches;
+        entry.nanoseconds += i.value().nanoseconds;
+    }
+}
+
+QList<LexerProfiler::RuleStatistics> LexerProfiler::statistics() {
+/*  -returns the statistics collected for every rule since the last reset */
+    return ruleStatistics.values();
+}
+
+void LexerProfiler::reset() {
+/*  -clears all the statistics collected */
+    ruleStatistics.clear();
+}
+
+QByteArray LexerProfiler::toJson() {
+/*  -returns the statistics collected for every rule as a JSON document */
+    QJsonArray rules;
+
+    foreach (const RuleStatistics& entry, ruleStatistics) {
+        QJsonObject rule;
+        rule.insert("language", entry.language);
+        rule.insert("rule", entry.name);
+        rule.insert("class", entry.id);
+        rule.insert("attempts", double(entry.attempts));
+        rule.insert("matches", double(entry.matches));
+        rule.insert("partial_matches", double(entry.partialMatches));
+        rule.insert("time_ms", entry.nanoseconds / 1000000.0);
+        rules.append(rule);
+    }
+
+    return QJsonDocument(rules).toJson();
+}
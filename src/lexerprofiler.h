@@ -0,0 +1,115 @@
+/*
+Project: Lepton Editor
+File: lexerprofiler.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LexerProfiler class.  When profiling is enabled,
+    `LeptonLexer` records how many times each token rule was tried, how many times it matched
+    (fully or partially) and how much time was spent matching it.  This is used to find which
+    rules of a language file make highlighting slow.
+
+    Profiling is disabled by default.  While it is disabled, the only cost to the lexer is a
+    (predictable) branch per rule check.  Defining `LEPTON_NO_LEXER_PROFILING` removes even
+    that, at compile time.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LEXERPROFILER_H
+#define LEXERPROFILER_H
+
+//include Qt classes
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QRegularExpression>
+#include <QtGlobal>
+
+//include other Lepton files needed by this class
+#include "leptonlexer.h"
+
+
+
+#ifdef LEPTON_NO_LEXER_PROFILING
+#define LEXER_PROFILING_ENABLED() false
+#else
+#define LEXER_PROFILING_ENABLED() Q_UNLIKELY(LexerProfiler::enabled)
+#endif
+
+
+
+class LexerProfiler {
+/* -A class that collects statistics about the token rules checked by the lexers. */
+
+    public:
+        struct RuleStatistics {
+                QString language;       //name of the language the rule belongs to
+                QString name;           //name of the rule
+                int id;                 //style class of the rule
+                qint64 attempts;        //number of times the rule was checked
+                qint64 matches;         //number of times the rule matched
+                qint64 partialMatches;  //number of times the rule partially matched
+                qint64 nanoseconds;     //total time spent checking the rule
+
+                RuleStatistics() : id(0), attempts(0), matches(0), partialMatches(0), nanoseconds(0) {}
+        };
+
+        typedef QHash<const QRegularExpression*, RuleStatistics> CallStatistics;
+
+        static bool enabled;    //true if the lexers should collect statistics (use `LEXER_PROFILING_ENABLED()` to check it)
+
+        static QRegularExpressionMatch profiledMatch(const QRegularExpression* expression, const QString& text, CallStatistics& callStatistics,
+                                                     QRegularExpression::MatchType matchType = QRegularExpression::PartialPreferFirstMatch);
+        /*  -matches `expression` against `text` (allowing partial matches, by default) and records the result in `callStatistics` */
+
+        static int profiledMatch(const QRegularExpression* expression, NativeMatcher native, const QString& text, CallStatistics& callStatistics, bool partial);
+        /*
+            -matches `native`, the native matcher of `expression`, against `text` and records the result in
+             `callStatistics` as a result of `expression`
+            -returns the result of `native`
+        */
+
+        static void addStatistics(const TokenRule* root, const CallStatistics& callStatistics);
+        /*
+            -adds the statistics collected during one call to `LeptonLexer::styleText()` to the
+             statistics of the rules of the language whose root rule is `root`
+        */
+
+        static QList<RuleStatistics> statistics();
+        /*  -returns the statistics collected for every rule since the last reset */
+
+        static void reset();
+        /*  -clears all the statistics collected */
+
+        static QByteArray toJson();
+        /*  -returns the statistics collected for every rule as a JSON document */
+
+    private:
+        static QHash<QString, RuleStatistics> ruleStatistics;  //statistics of every rule (indexed by language, rule name and class)
+};
+
+#endif // LEXERPROFILER_H
@@ -0,0 +1,162 @@
+/*
+Project: Lepton Editor
+File: lexerprofilerpanel.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LexerProfilerPanel class.  It is a dockable
+    panel used to enable lexer profiling, to display the statistics collected for every
+    token rule and to export them to a JSON file.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "lexerprofilerpanel.h"
+
+//include Qt classes
+#include <QWidget>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QTableWidgetItem>
+#include <QFileDialog>
+#include <QFile>
+#include <QMessageBox>
+#include <QDir>
+
+//include other Lepton files used for this class implementation
+#include "lexerprofiler.h"
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LexerProfilerPanel::LexerProfilerPanel(QWidget* parent) : QDockWidget("Lexer Profiler", parent) {
+/*  -Class constructor */
+    setObjectName("lexerProfilerPanel");
+
+    QWidget* contents = new QWidget(this);
+    QVBoxLayout* layout = new QVBoxLayout(contents);
+
+    //create the buttons used to control the profiler
+    QHBoxLayout* buttonLayout = new QHBoxLayout();
+    profileButton = new QPushButton("Profile", contents);
+    profileButton->setCheckable(true);
+    profileButton->setChecked(LexerProfiler::enabled);
+    QPushButton* resetButton = new QPushButton("Reset", contents);
+    QPushButton* exportButton = new QPushButton("Export...", contents);
+    buttonLayout->addWidget(profileButton);
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addWidget(exportButton);
+    buttonLayout->addStretch();
+    layout->addLayout(buttonLayout);
+
+    //create the table in which the statistics are displayed
+    statisticsTable = new QTableWidget(0, 7, contents);
+    statisticsTable->setHorizontalHeaderLabels( QStringList() << "Language" << "Rule" << "Class" << "Attempts" << "Matches" << "Partial Matches" << "Time (ms)" );
+    statisticsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    statisticsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    statisticsTable->verticalHeader()->hide();
+    statisticsTable->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(statisticsTable);
+
+    setWidget(contents);
+
+    //the table is updated periodically, but only while statistics are being collected
+    refreshTimer.setInterval(1000);
+
+    connect(profileButton, SIGNAL(toggled(bool)), this, SLOT(setProfiling(bool)));
+    connect(resetButton, SIGNAL(clicked()), this, SLOT(resetStatistics()));
+    connect(exportButton, SIGNAL(clicked()), this, SLOT(exportStatistics()));
+    connect(&refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+}
+
+
+
+//~private slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void LexerProfilerPanel::setProfiling(bool enabled) {
+/*  -enables or disables the collection of statistics by the lexers */
+#ifdef LEPTON_NO_LEXER_PROFILING
+    if (enabled) {
+        QMessageBox::information(this, "Lexer Profiler", "Lexer profiling is not available in this build of Lepton.");
+        profileButton->setChecked(false);
+    }
+#else
+    LexerProfiler::enabled = enabled;
+    if (enabled) refreshTimer.start();
+    else refreshTimer.stop();
+    refresh();
+#endif
+}
+
+void LexerProfilerPanel::refresh() {
+/*  -updates the table with the statistics collected so far */
+    QList<LexerProfiler::RuleStatistics> statistics = LexerProfiler::statistics();
+
+    statisticsTable->setSortingEnabled(false);  //rows must not move while they are being filled
+    statisticsTable->setRowCount( statistics.count() );
+
+    for (int row = 0, count = statistics.count(); row < count; row++) {
+        const LexerProfiler::RuleStatistics& entry = statistics.at(row);
+
+        QTableWidgetItem* items[7];
+        for (int column = 0; column < 7; column++) items[column] = new QTableWidgetItem();
+        items[0]->setText(entry.language);
+        items[1]->setText(entry.name);
+        items[2]->setData(Qt::DisplayRole, entry.id);
+        items[3]->setData(Qt::DisplayRole, entry.attempts);
+        items[4]->setData(Qt::DisplayRole, entry.matches);
+        items[5]->setData(Qt::DisplayRole, entry.partialMatches);
+        items[6]->setData(Qt::DisplayRole, entry.nanoseconds / 1000000.0);
+
+        for (int column = 0; column < 7; column++) statisticsTable->setItem(row, column, items[column]);
+    }
+
+    statisticsTable->setSortingEnabled(true);
+}
+
+void LexerProfilerPanel::resetStatistics() {
+/*  -clears the statistics collected so far */
+    LexerProfiler::reset();
+    refresh();
+}
+
+void LexerProfilerPanel::exportStatistics() {
+/*  -asks for a file name and saves the statistics collected so far to it, as JSON */
+    QString filePath = QFileDialog::getSaveFileName(this, "Export Lexer Statistics", QDir::homePath(), "JSON files (*.json)");
+    if ( filePath.isEmpty() ) return;
+
+    QFile file(filePath);
+    if (! file.open(QIODevice::WriteOnly | QIODevice::Truncate) ) {
+        QMessageBox::warning(this, "Lexer Profiler", QString("Could not write to \"%1\".").arg(filePath));
+        return;
+    }
+    file.write( LexerProfiler::toJson() );
+    file.close();
+}
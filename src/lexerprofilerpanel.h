@@ -0,0 +1,75 @@
+/*
+Project: Lepton Editor
+File: lexerprofilerpanel.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LexerProfilerPanel class.  It is a dockable
+    panel used to enable lexer profiling, to display the statistics collected for every
+    token rule and to export them to a JSON file.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LEXERPROFILERPANEL_H
+#define LEXERPROFILERPANEL_H
+
+//include Qt classes
+#include <QDockWidget>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QTimer>
+
+
+
+class LexerProfilerPanel : public QDockWidget {
+/* -A dockable panel that displays the statistics collected by the lexer profiler. */
+
+    Q_OBJECT
+
+    public:
+        explicit LexerProfilerPanel(QWidget* parent = 0);
+        /*  -Class constructor */
+
+    private:
+        QTableWidget* statisticsTable;  //table in which the statistics of every rule are displayed
+        QPushButton* profileButton;     //button used to enable or disable profiling
+        QTimer refreshTimer;            //timer used to update the table while profiling
+
+    private slots:
+        void setProfiling(bool enabled);
+        /*  -enables or disables the collection of statistics by the lexers */
+
+        void refresh();
+        /*  -updates the table with the statistics collected so far */
+
+        void resetStatistics();
+        /*  -clears the statistics collected so far */
+
+        void exportStatistics();
+        /*  -asks for a file name and saves the statistics collected so far to it, as JSON */
+};
+
+#endif // LEXERPROFILERPANEL_H
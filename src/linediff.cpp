@@ -0,0 +1,206 @@
+/*
+Project: Lepton Editor
+File: linediff.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LineDiff class.  It finds the lines which differ
+    between two versions of a text using Myers' difference algorithm on hashes of the lines.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "linediff.h"
+
+//include Qt classes
+#include <QHash>
+
+//include other standard library classes
+#include <cstring>
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+struct TextLines {
+    const char* text;       //the text
+    QVector<int> starts;    //position of each line, followed by the length of the text
+    QVector<uint> hashes;   //hash of each line (including its line ending)
+
+    TextLines(const char* _text, int length) : text(_text), starts( LineDiff::lineStarts(_text, length) ) {
+        hashes.resize(starts.size() - 1);
+        for (int i = 0; i < hashes.size(); i++) hashes[i] = qHashBits(text + starts.at(i), starts.at(i + 1) - starts.at(i));
+    }
+
+    int count() const { return hashes.size(); }
+    int lineLength(int line) const { return starts.at(line + 1) - starts.at(line); }
+};
+
+static bool sameLine(const TextLines& a, int lineA, const TextLines& b, int lineB) {
+/*  -returns true if line `lineA` of `a` is the same as line `lineB` of `b` (hashes are only compared first) */
+    if ( a.hashes.at(lineA) != b.hashes.at(lineB) ) return false;
+    const int length = a.lineLength(lineA);
+    return length == b.lineLength(lineB) && std::memcmp(a.text + a.starts.at(lineA), b.text + b.starts.at(lineB), length) == 0;
+}
+
+static void addHunk(QVector<LineDiff::Hunk>& hunks, const TextLines& a, int lineA, int countA, const TextLines& b, int lineB, int countB) {
+/*  -adds a hunk replacing `countA` lines of `a` from `lineA` with `countB` lines of `b` from `lineB` to `hunks` */
+    LineDiff::Hunk hunk;
+    hunk.oldLine = lineA;
+    hunk.oldCount = countA;
+    hunk.newLine = lineB;
+    hunk.newCount = countB;
+    hunk.oldPosition = a.starts.at(lineA);
+    hunk.oldLength = a.starts.at(lineA + countA) - hunk.oldPosition;
+    hunk.newPosition = b.starts.at(lineB);
+    hunk.newLength = b.starts.at(lineB + countB) - hunk.newPosition;
+    hunks.append(hunk);
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+QVector<int> LineDiff::lineStarts(const char* text, int length) {
+/*
+-returns the position at which each line of the `length` bytes at `text` starts, followed by `length`
+-lines end with "\r\n", "\n" or "\r", as in Scintilla
+*/
+    QVector<int> starts;
+    starts.append(0);
+    for (int i = 0; i < length; i++) {
+        if (text[i] == '\r') {
+            if (i + 1 < length && text[i + 1] == '\n') i++;
+            starts.append(i + 1);
+        }
+        else if (text[i] == '\n') starts.append(i + 1);
+    }
+    starts.append(length);
+    return starts;
+}
+
+QVector<LineDiff::Hunk> LineDiff::diff(const char* oldText, int oldLength, const char* newText, int newLength, int maxEdits) {
+/*
+-returns the lines, in increasing order, which must be replaced to change the old text into the new text
+-if the texts differ by more than `maxEdits` inserted or removed lines, the lines between the first and
+ the last difference are returned as a single hunk
+*/
+
+    /*##########################################################################################
+    ### Lines are compared by their hashes (and only compared byte by byte if these match).   ##
+    ### The lines which are the same at the start and at the end of both texts are skipped    ##
+    ### first, which leaves very little to compare when a file was only changed in a few      ##
+    ### places.  The rest is compared with Myers' algorithm, which takes a time proportional  ##
+    ### to the number of lines times the number of differences.  The furthest point reached   ##
+    ### on each diagonal is kept for every number of differences, so that the shortest edit  ##
+    ### can be traced back once the end of both texts is reached.                            ##
+    ##########################################################################################*/
+
+    QVector<Hunk> hunks;
+    const TextLines a(oldText, oldLength);
+    const TextLines b(newText, newLength);
+
+    int prefix = 0;
+    while (prefix < a.count() && prefix < b.count() && sameLine(a, prefix, b, prefix)) prefix++;
+    int suffix = 0;
+    while (suffix < a.count() - prefix && suffix < b.count() - prefix && sameLine(a, a.count() - 1 - suffix, b, b.count() - 1 - suffix)) suffix++;
+
+    const int n = a.count() - prefix - suffix;     //number of lines left to compare in the old text
+    const int m = b.count() - prefix - suffix;     //number of lines left to compare in the new text
+    if (n == 0 && m == 0) return hunks;
+    if (n == 0 || m == 0) {
+        addHunk(hunks, a, prefix, n, b, prefix, m);
+        return hunks;
+    }
+
+    const int limit = qMin(n + m, maxEdits);
+    const int offset = limit + 1;
+    QVector<int> v(2 * limit + 3, 0);
+    QVector< QVector<int> > trace;
+    int edits = -1;
+
+    for (int d = 0; d <= limit && edits < 0; d++) {
+        trace.append(v);
+        for (int k = -d; k <= d; k += 2) {
+            int x = (k == -d || (k != d && v.at(offset + k - 1) < v.at(offset + k + 1))) ? v.at(offset + k + 1) : v.at(offset + k - 1) + 1;
+            int y = x - k;
+            while (x < n && y < m && sameLine(a, prefix + x, b, prefix + y)) {
+                x++;
+                y++;
+            }
+            v[offset + k] = x;
+            if (x >= n && y >= m) {
+                edits = d;
+                break;
+            }
+        }
+    }
+
+    //too many differences: everything between the common start and end is replaced
+    if (edits < 0) {
+        addHunk(hunks, a, prefix, n, b, prefix, m);
+        return hunks;
+    }
+
+    //trace the path back, collecting the lines which are the same (as pairs of line numbers, from the last)
+    QVector<int> matchesA;
+    QVector<int> matchesB;
+    int x = n;
+    int y = m;
+    for (int d = edits; d >= 0; d--) {
+        const QVector<int>& previous = trace.at(d);
+        const int k = x - y;
+        int previousK;
+        if (d == 0) previousK = 0;
+        else previousK = (k == -d || (k != d && previous.at(offset + k - 1) < previous.at(offset + k + 1))) ? k + 1 : k - 1;
+        const int previousX = d == 0 ? 0 : previous.at(offset + previousK);
+        const int previousY = previousX - previousK;
+
+        while (x > previousX && y > previousY) {
+            x--;
+            y--;
+            matchesA.append(x);
+            matchesB.append(y);
+        }
+        x = previousX;
+        y = previousY;
+    }
+
+    //the lines between two matching lines are replaced
+    int nextA = 0;
+    int nextB = 0;
+    for (int i = matchesA.size() - 1; i >= -1; i--) {
+        const int matchA = i >= 0 ? matchesA.at(i) : n;
+        const int matchB = i >= 0 ? matchesB.at(i) : m;
+        if (matchA > nextA || matchB > nextB) addHunk(hunks, a, prefix + nextA, matchA - nextA, b, prefix + nextB, matchB - nextB);
+        nextA = matchA + 1;
+        nextB = matchB + 1;
+    }
+
+    return hunks;
+}
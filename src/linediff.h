@@ -0,0 +1,73 @@
+/*
+Project: Lepton Editor
+File: linediff.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LineDiff class.  It finds the lines which differ
+    between two versions of a text, so that a document can be updated to a new version of its
+    file by only replacing the lines which changed.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LINEDIFF_H
+#define LINEDIFF_H
+
+//include Qt classes
+#include <QVector>
+
+
+
+class LineDiff {
+/* -A class with functions to compare two texts line by line. */
+
+    public:
+        struct Hunk {
+                int oldLine;        //first line replaced in the old text
+                int oldCount;       //number of lines replaced in the old text
+                int newLine;        //first line replacing them in the new text
+                int newCount;       //number of lines replacing them
+                int oldPosition;    //position of the first line replaced in the old text
+                int oldLength;      //length of the lines replaced (including their line endings)
+                int newPosition;    //position of the first line replacing them in the new text
+                int newLength;      //length of the lines replacing them (including their line endings)
+        };
+
+        static QVector<int> lineStarts(const char* text, int length);
+        /*
+            -returns the position at which each line of the `length` bytes at `text` starts, followed by `length`
+            -lines end with "\r\n", "\n" or "\r", as in Scintilla
+        */
+
+        static QVector<Hunk> diff(const char* oldText, int oldLength, const char* newText, int newLength, int maxEdits = 1000);
+        /*
+            -returns the lines, in increasing order, which must be replaced to change the old text into the new text
+            -if the texts differ by more than `maxEdits` inserted or removed lines, the lines between the first and
+             the last difference are returned as a single hunk
+        */
+};
+
+#endif // LINEDIFF_H
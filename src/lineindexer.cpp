@@ -0,0 +1,106 @@
+/*
+Project: Lepton Editor
+File: lineindexer.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LineIndexer class.  It builds a sparse index
+    of the lines of a file on a worker thread.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "lineindexer.h"
+
+//include other Lepton files used for this class implementation
+#include "mappedfile.h"
+
+//include other standard library classes
+#include <cstring>
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LineIndexer::LineIndexer(const QString& _filePath, int _linesPerEntry, QObject* parent)
+    : QObject(parent), filePath(_filePath), linesPerEntry(_linesPerEntry), canceled(0) {
+/*  -Class constructor */
+}
+
+void LineIndexer::cancel() {
+/*  -stops indexing the file as soon as possible (can be called from any thread) */
+    canceled.storeRelease(1);
+}
+
+
+
+//~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void LineIndexer::index() {
+/*  -scans the file, emitting `indexed()` after each block, and then emits `finished()` */
+
+    /*######################################################################################
+    ### Only one line start in every `linesPerEntry` is recorded, so the index of a file ##
+    ### of tens of gigabytes stays small; the lines in between are found by scanning     ##
+    ### from the closest entry.  Line breaks are found with `memchr()`, which checks     ##
+    ### many bytes at a time, and the file is mapped a block at a time so the scan does  ##
+    ### not keep more of the file in memory than the system is willing to cache.        ##
+    ######################################################################################*/
+
+    MappedFile file;
+    if ( !file.open(filePath) ) {
+        emit finished();
+        return;
+    }
+
+    const qint64 blockSize = 16777216;
+    QVector<qint64> entries;
+    entries.append(0);      //line 0 starts at the start of the file
+    qint64 lineCount = 0;
+
+    for (qint64 blockStart = 0; blockStart < file.size(); blockStart += blockSize) {
+        if ( canceled.loadAcquire() != 0 ) break;
+
+        const qint64 length = qMin(blockSize, file.size() - blockStart);
+        const char* block = reinterpret_cast<const char*>( file.map(blockStart, length) );
+        if (block == 0) break;
+
+        const char* end = block + length;
+        for (const char* p = block; p < end; p++) {
+            p = static_cast<const char*>( std::memchr(p, '\n', end - p) );
+            if (p == 0) break;
+            lineCount++;
+            if (lineCount % linesPerEntry == 0) entries.append( blockStart + (p - block) + 1 );
+        }
+
+        emit indexed(entries, lineCount, blockStart + length);
+        entries.clear();
+    }
+
+    emit finished();
+}
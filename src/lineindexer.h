@@ -0,0 +1,83 @@
+/*
+Project: Lepton Editor
+File: lineindexer.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LineIndexer class.  It scans a file on a worker
+    thread and records where every so many lines start (a sparse index of the lines), so that
+    any line of a file too large to be loaded can be found quickly.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LINEINDEXER_H
+#define LINEINDEXER_H
+
+//include Qt classes
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+
+
+
+class LineIndexer : public QObject {
+/*
+-A class that builds a sparse index of the lines of a file (meant to be moved to a worker thread).
+-Entry `i` of the index is the offset at which line `i * linesPerEntry` starts.
+*/
+
+    Q_OBJECT
+
+    public:
+        LineIndexer(const QString& _filePath, int _linesPerEntry, QObject* parent = 0);
+        /*  -Class constructor */
+
+        void cancel();
+        /*  -stops indexing the file as soon as possible (can be called from any thread) */
+
+    public slots:
+        void index();
+        /*  -scans the file, emitting `indexed()` after each block, and then emits `finished()` */
+
+    signals:
+        void indexed(const QVector<qint64>& entries, qint64 lineCount, qint64 bytesIndexed);
+        /*
+            -emitted when a block of the file was scanned
+            -`entries` are the entries added to the index since it was last emitted, `lineCount` the number of
+             line breaks found so far, and `bytesIndexed` the number of bytes scanned so far
+        */
+
+        void finished();
+        /*  -emitted when the whole file was scanned (or when scanning it was canceled or failed) */
+
+    private:
+        QString filePath;       //path to the file being indexed
+        int linesPerEntry;      //number of lines between entries of the index
+        QAtomicInt canceled;    //non-zero if indexing the file was canceled
+};
+
+#endif // LINEINDEXER_H
@@ -42,13 +42,24 @@ Usage Agreement:
 #include <QMessageBox>
 #include <QVariant>
 #include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QInputDialog>
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "leptonconfig.h"
 #include "sessionmanager.h"
+#include "savetransforms.h"
+#include "editjournal.h"
+#include "prefetchjob.h"
+#include "hexviewer.h"
+#include "largefileviewer.h"
+#include "textencoding.h"
 
 #include <QDebug>
 
+#include <climits>
+
 //~public method implementations~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow) {
@@ -75,6 +86,17 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     statusLabel = new QLabel();
     ui->statusBar->addPermanentWidget(statusLabel);
 
+    //the progress of large files being loaded is only shown while they are being loaded
+    loadProgressBar = new QProgressBar();
+    loadProgressBar->setRange(0, 1000);
+    loadProgressBar->setMaximumWidth(200);
+    loadProgressBar->hide();
+    ui->statusBar->addPermanentWidget(loadProgressBar);
+    cancelLoadButton = new QPushButton(tr("Cancel"));
+    cancelLoadButton->hide();
+    ui->statusBar->addPermanentWidget(cancelLoadButton);
+    connect(cancelLoadButton, SIGNAL(clicked()), this, SLOT(cancelFileLoad()));
+
     //setup other windows
     configsEditor.setParent(this, Qt::Dialog);
     findReplace.setParent(this, Qt::Dialog);
@@ -91,6 +113,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     projectView->setModel(projectListModel);
     projectView->setContextMenuPolicy(Qt::CustomContextMenu);
 
+    //the lexer profiler panel is hidden until it is requested from the "View" menu
+    profilerPanel = new LexerProfilerPanel(this);
+    addDockWidget(Qt::BottomDockWidgetArea, profilerPanel);
+    profilerPanel->hide();
+    ui->menuView->addAction( profilerPanel->toggleViewAction() );
+
     //connect signals to appropriate slots
     connect(projectView, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(projectItemContextMenuRequested(QPoint)) );
     connect(projectListModel, SIGNAL(requestOpenFile(QFileInfo)), this, SLOT(openFileRequested(QFileInfo)));
@@ -103,6 +131,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     connect(&findReplace, SIGNAL(replaceClicked(FindReplaceDialog::DialogParameters)), this, SLOT(replaceInCurrent(FindReplaceDialog::DialogParameters)) );
     connect(&sessionManager, SIGNAL(aboutToChangeSession()), this, SLOT(saveSession()));
     connect(&sessionManager, SIGNAL(changedSession()), this, SLOT(loadSession()));
+    connect(&prefetchTimer, SIGNAL(timeout()), this, SLOT(prefetchDeferredTab()));
+
+    //the files of tabs restored from a session are loaded one at a time, leaving the editor responsive in between
+    prefetchTimer.setSingleShot(true);
 
     QString styleSheet;
     LeptonConfig::mainSettings->getStyleSheetInto(styleSheet);
@@ -110,12 +142,17 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 
     //load previous session
     loadSession();
+
+    //recover the changes which were not saved when Lepton last crashed
+    recoverUnsavedChanges();
 }
 
 MainWindow::~MainWindow() {
     //delete projectListModel;
     delete projectListModel;
     delete statusLabel;
+    delete loadProgressBar;
+    delete cancelLoadButton;
     delete ui;
 }
 
@@ -125,7 +162,12 @@ MainWindow::~MainWindow() {
 
 void MainWindow::closeEvent(QCloseEvent *event) {
 /* -called whenever a close window is requested */
+    //let files being saved in the background (and the saves queued after them) finish writing, and be marked as saved
+    for (int i = 0, l = editors->count(); i < l; i++) {
+        if ( editors->getEditor(i) != 0 ) editors->getEditor(i)->waitForSave();
+    }
     saveSession();
+    prefetchTimer.stop();   //files of tabs which are about to be closed are not loaded anymore
     disconnect(editors, SIGNAL(currentChanged(int)), this, SLOT(editTabChanged()) );
     int err = editors->closeAll();  //request to close all open tabs
     if (err != 0) event->ignore();  //if a tab was not closed, do not close the window
@@ -156,7 +198,7 @@ void MainWindow::on_actionSave_triggered() {
 
 void MainWindow::save_signal_received(int index) {
 /* -save contents of tab with specified index */
-    saveFile( index );
+    saveFile( index, false );   //the tab is about to be closed, so the file must be written before it is
 }
 
 void MainWindow::on_actionSave_As_triggered() {
@@ -181,18 +223,48 @@ void MainWindow::on_actionEditor_Tools_toggled(bool visible) {
 
 void MainWindow::on_actionSave_All_triggered() {
 /* -save changes to all documents */
+    //the files are written in parallel, in the background; documents with no changes are not written again
     for (int i = 0, l = editors->count(); i < l; i++) {
+        ScintillaEditor* editor = editors->getEditor(i);
+        if ( editor == 0 ) continue;                                        //viewers can not change their file
+        if ( editor->isFileOpen() && editor->wasFileSaved() ) continue;
+        if ( editor->documentOwner()->isSaving() ) continue;    //the document is shown in another tab which was already saved
         saveFile(i);
     }
 }
 
+void MainWindow::on_actionNew_View_triggered() {
+/*  -opens another tab showing the document in the current tab */
+    ScintillaEditor* current = editors->current();
+    if ( current == 0 || current->isLoading() ) return;
+
+    QString label = editors->tabText( editors->currentIndex() );
+    int index = insertTab();
+    editors->getEditor(index)->showDocumentOf(current);
+    editors->setTabText(index, label);
+    editors->setCurrentIndex(index);
+}
+
+void MainWindow::on_actionFollow_File_triggered(bool follow) {
+/*  -turns follow mode (showing text appended to the file, ex. a log) on or off for the current tab file */
+    ScintillaEditor* current = editors->current();
+    if ( current == 0 || !current->setFollowing(follow) ) {
+        ui->actionFollow_File->setChecked(false);
+        ui->statusBar->showMessage(tr("Only a saved file which is fully loaded can be followed."), 5000);
+    }
+}
+
 void MainWindow::editTabChanged() {
 /* -called when visible tab is changed to update main window */
     if (editors->count() > 0) {
+        loadDeferredTab( editors->currentIndex() );    //tabs restored from the session are loaded when they are first shown (or become viewers)
         setLanguageSelectorMenu();
         setSpaceTabSelector();
-        editors->current()->setFocus(Qt::TabFocusReason);
+        ui->actionFollow_File->setEnabled( editors->current() != 0 );
+        ui->actionFollow_File->setChecked( editors->current() != 0 && editors->current()->isFollowing() );
+        editors->currentWidget()->setFocus(Qt::TabFocusReason);
         updateStatusLabel();
+        updateLoadProgress();
     }
 }
 
@@ -261,18 +333,19 @@ void MainWindow::on_actionSettings_Editor_triggered() {
 
 void MainWindow::changeSpaceTabUse(QAction* actionTriggered) {
 /*  -sets the current editor tab to use tabs or spaces, depending on `actionTriggered` */
+    if ( editors->current() == 0 ) return;
     if ( actionTriggered->text() == ui->actionUse_Spaces->text() ) editors->current()->setIndentationsUseTabs(false);
     else if ( actionTriggered->text() == ui->actionUse_Tabs->text() ) editors->current()->setIndentationsUseTabs(true);
 }
 
 void MainWindow::on_actionReplace_Tabs_with_Spaces_triggered() {
 /*  -called to replace tabs with spaces */
-    editors->current()->changeTabsToSpaces();
+    if ( editors->current() != 0 ) editors->current()->changeTabsToSpaces();
 }
 
 void MainWindow::on_actionReplace_Spaces_with_Tabs_triggered(){
 /*  -called to replace spaces with tabs */
-    editors->current()->changeSpacesToTabs();
+    if ( editors->current() != 0 ) editors->current()->changeSpacesToTabs();
 }
 
 void MainWindow::on_action_Find_Replace_triggered(){
@@ -282,31 +355,61 @@ void MainWindow::on_action_Find_Replace_triggered(){
 
 void MainWindow::findInCurrent(const FindReplaceDialog::DialogParameters& parameters) {
 /*  -called to perform a "find" on the current tab file using the data in `parameters` */
+    LargeFileViewer* viewer = qobject_cast<LargeFileViewer*>( editors->currentWidget() );
+    if (viewer != 0) viewer->find(parameters.findText, parameters.caseSensitive);    //large files are searched for plain text
+    if ( editors->current() == 0 ) return;
     editors->current()->findFirst(parameters.findText, parameters.isRegex, parameters.caseSensitive,
                                   parameters.matchWholeWord, parameters.wrap, parameters.forwardSearch);
 }
 
 void MainWindow::findNextInCurrent() {
 /*  -called to perform a "find next" on the current tab file (should be called after `findInCurrent()` ) */
-    editors->current()->findNext();
+    LargeFileViewer* viewer = qobject_cast<LargeFileViewer*>( editors->currentWidget() );
+    if (viewer != 0) viewer->findNext();
+    if ( editors->current() != 0 ) editors->current()->findNext();
+}
+
+void MainWindow::on_actionGo_to_Line_triggered() {
+/*  -called to go to a line of the current tab file */
+    LargeFileViewer* viewer = qobject_cast<LargeFileViewer*>( editors->currentWidget() );
+    if (editors->current() == 0 && viewer == 0) return;
+
+    bool accepted = false;
+    QString text = QInputDialog::getText(this, tr("Go to Line"), tr("Line number:"), QLineEdit::Normal, QString(), &accepted);
+    bool valid = false;
+    qint64 line = text.trimmed().toLongLong(&valid);
+    if (!accepted || !valid || line < 1) return;
+
+    if (viewer != 0) viewer->gotoLine(line - 1);
+    else {
+        ScintillaEditor* editor = editors->current();
+        int lineIndex = int( qMin(line, qint64( editor->lines() )) ) - 1;
+        editor->setCursorPosition(lineIndex, 0);
+        editor->ensureLineVisible(lineIndex);
+        editor->setFocus();
+    }
 }
 
 void MainWindow::replaceInCurrent(const FindReplaceDialog::DialogParameters& parameters) {
 /*  -called to perform a "replace" on the current tab file using the data in `parameters` */
-    editors->current()->replace(parameters.replaceText);
+    if ( editors->current() != 0 ) editors->current()->replace(parameters.replaceText);
 }
 
 /*
 remove trailing spaces from the current file
 */
 void MainWindow::on_actionRemove_trailing_spaces_triggered(){
-    editors->current()->removeTrailingSpaces();
+    if ( editors->current() != 0 ) editors->current()->removeTrailingSpaces();
 }
 
 /*
 update the status bar label
 */
 void MainWindow::updateStatusLabel() {
+    if ( editors->current() == 0 ) {        //viewers have no caret
+        statusLabel->clear();
+        return;
+    }
     int line = 0;
     int col = 0;
     editors->current()->getCursorPosition(&line, &col);
@@ -317,6 +420,71 @@ void MainWindow::updateStatusLabel() {
     statusLabel->setText(labelText);
 }
 
+void MainWindow::updateLoadProgress() {
+/*  -shows the progress of the file being loaded in the current tab (if any) on the status bar */
+    ScintillaEditor* editor = editors->current();
+    bool loading = editor != 0 && editor->isLoading();
+
+    //progress reported by editors in other tabs is not shown
+    if ( sender() != 0 && sender() != editor && sender() != editors ) return;
+
+    if (loading) loadProgressBar->setValue( editor->loadFraction() * 1000 );
+    else setSpaceTabSelector();     //the indentation may have been detected from the file once it was loaded
+    loadProgressBar->setVisible(loading);
+    cancelLoadButton->setVisible(loading);
+}
+
+void MainWindow::showSaveError(const QString& filePath, const QString& errorString) {
+/*  -reports that a file saved in the background could not be written (without blocking other saves) */
+    ui->statusBar->showMessage(tr("Cannot write to file %1: %2").arg(filePath).arg(errorString));
+}
+
+void MainWindow::cancelFileLoad() {
+/*  -stops loading the file being loaded in the current tab */
+    if ( editors->current() != 0 ) editors->current()->cancelLoading();
+}
+
+void MainWindow::prefetchDeferredTab() {
+/*  -loads the file of one of the tabs restored from the session which were not shown yet */
+    if (editors->count() < 1) return;
+
+    //wait for a large file being loaded in the current tab, so it is not slowed down
+    if ( editors->current() != 0 && editors->current()->isLoading() ) {
+        prefetchTimer.start();
+        return;
+    }
+
+    //the tabs closest to the current one are the most likely to be shown next, so they are loaded first
+    bool waiting = false;
+    foreach (int index, tabsByDistance()) {
+        ScintillaEditor* editor = editors->getEditor(index);
+        if ( editor == 0 || !editor->isLoadDeferred() ) continue;
+        if ( pendingPrefetches.contains(editor->getOpenFilePath()) ) {
+            waiting = true;             //the tab is loaded once its file was read (see `filePrefetched()`)
+            continue;
+        }
+        loadDeferredTab(index);
+        prefetchTimer.start();          //the next tab is loaded once the events which came in meanwhile are handled
+        return;
+    }
+
+    //files read for tabs which were closed in the meantime are not needed anymore
+    if (! waiting) prefetchedFiles.clear();
+}
+
+void MainWindow::filePrefetched(const PrefetchJob::Contents& contents) {
+/*  -called when the file of a tab restored from the session was read in the background */
+    if ( !pendingPrefetches.remove(contents.filePath) ) return;    //the file was read for a session which was closed since
+    prefetchedFiles.insert(contents.filePath, contents);
+
+    //the current tab is loaded as soon as its file was read; the others are loaded when the editor is idle
+    ScintillaEditor* current = editors->current();
+    if ( current != 0 && current->isLoadDeferred() && current->getOpenFilePath() == contents.filePath ) {
+        editTabChanged();
+    }
+    if ( !prefetchTimer.isActive() ) prefetchTimer.start();
+}
+
 /*
 -load settings and configs from saved session
 */
@@ -324,16 +492,60 @@ void MainWindow::loadSession() {
     projectListModel->loadSession();
 
     // remove currently opened files
+    prefetchTimer.stop();
+    pendingPrefetches.clear();
+    prefetchedFiles.clear();
     editors->closeAll();
 
-    // load previously opened files
+    // restore the tabs of previously opened files; their files are only read when the tabs are shown, or while the editor is idle
     QList< QVariant > fileList = sessionManager.value("listOfOpenFiles").toList();
+    QList< QVariant > cursorList = sessionManager.value("openFileCursors").toList();
+    int currentFile = sessionManager.value("currentFileIndex", 0).toInt();
+    int currentTab = -1;
+    QSet< QString > restoredFiles;
     for (int i = 0, c = fileList.count(); i < c; i++) {
-        this->openFile( fileList.at(i).toString() );
+        QString filePath = fileList.at(i).toString();
+        if ( filePath.isEmpty() || restoredFiles.contains(filePath) ) continue;    //untitled tabs and other views of a document are not restored
+        restoredFiles.insert(filePath);
+
+        QPoint cursor = i < cursorList.count() ? cursorList.at(i).toPoint() : QPoint();
+        int index = insertTab();
+        editors->getEditor(index)->deferLoading(filePath, cursor.y(), cursor.x());
+        editors->setTabText(index, QFileInfo(filePath).fileName());
+        if (i <= currentFile) currentTab = index;
     }
     //create a new editor if needed
     if (editors->count() == 0) insertTab();
 
+    // show (and load) the tab which was current, then load the others in the background
+    editors->blockSignals(true);    //the current tab is only loaded (below) once the files are being read in the background
+    if (currentTab >= 0) editors->setCurrentIndex(currentTab);
+    editors->blockSignals(false);
+    int prefetchInterval = LeptonConfig::mainSettings->getValueOrDefault(100, "session", "prefetch_interval").toInt();
+    if (prefetchInterval >= 0) {
+        /*###################################################################################
+        ### The files are all read at once on a pool of threads, starting with the one of  ##
+        ### the current tab and then by distance from it, so that restoring a session is  ##
+        ### bound by how many reads the disk can do at once rather than by the latency of  ##
+        ### each read.  Only copying the text into the editors is done on the main thread, ##
+        ### one tab at a time and in the same order.                                       ##
+        ###################################################################################*/
+        QList<int> order = tabsByDistance();
+        for (int i = 0; i < order.count(); i++) {
+            ScintillaEditor* editor = editors->getEditor( order.at(i) );
+            if ( editor == 0 || !editor->isLoadDeferred() ) continue;
+
+            PrefetchJob* job = new PrefetchJob( editor->getOpenFilePath() );
+            connect(job, SIGNAL(finished(PrefetchJob::Contents)), this, SLOT(filePrefetched(PrefetchJob::Contents)));
+            pendingPrefetches.insert( editor->getOpenFilePath() );
+            PrefetchJob::threadPool()->start(job, -i);     //jobs with a higher priority are started first
+        }
+
+        prefetchTimer.setInterval(prefetchInterval);
+        prefetchTimer.start();
+    }
+    editTabChanged();
+
     // load layout settings
     if ( sessionManager.value("windowMaximized").toBool() ) this->showMaximized();
     else this->resize( sessionManager.value("windowWidth").toInt(), sessionManager.value("windowHeight").toInt() );
@@ -361,10 +573,17 @@ void MainWindow::saveSession() {
 
     // save opened files
     QList< QVariant > fileList;
+    QList< QVariant > cursorList;
     for (int i = 0, c = editors->count(); i < c; i++) {
-        fileList.append( editors->getEditor(i)->getOpenFilePath() );
+        int line = 0;
+        int index = 0;
+        if ( editors->getEditor(i) != 0 ) editors->getEditor(i)->getSessionCursorPosition(&line, &index);
+        fileList.append( editors->filePathAt(i) );
+        cursorList.append( QPoint(index, line) );
     }
     sessionManager.setValue("listOfOpenFiles", fileList);
+    sessionManager.setValue("openFileCursors", cursorList);
+    sessionManager.setValue("currentFileIndex", editors->currentIndex());
 
     // save layout settings
     if ( this->isMaximized() ) sessionManager.setValue("windowMaximized", true);
@@ -393,16 +612,39 @@ void MainWindow::saveSession() {
 void MainWindow::openFile(const QString& filePath) {
 /* -opens a specified file in an editor tab */
     if ( filePath.isEmpty() ) return;
-    if ( (editors->count() < 1) || (! editors->current()->text().isEmpty()) ) { //if text is already presend in the current editor, create a new tab
+
+    //a file which is already open is not loaded again: its tab is shown instead (see "New View of Document" to show it twice)
+    for (int i = 0, c = editors->count(); i < c; i++) {
+        if ( !editors->filePathAt(i).isEmpty() && QFileInfo(editors->filePathAt(i)) == QFileInfo(filePath) ) {
+            editors->setCurrentIndex(i);
+            return;
+        }
+    }
+
+    //files which can not be edited (ex. binary files) are shown in a read-only viewer instead
+    QWidget* viewer = createViewerFor(filePath);
+    if (viewer != 0) {
+        editors->addViewer(viewer, QFileInfo(filePath).fileName());
+        return;
+    }
+
+    if ( (editors->current() == 0) || (! editors->current()->text().isEmpty()) || editors->current()->isLoading()
+         || editors->current()->hasOtherViews() || editors->current()->isLoadDeferred() ) { //if text is already presend in the current editor, create a new tab
         //qint8 i = editors->addTab();
         int i = insertTab();
         editors->setCurrentIndex(i);
     }
     editors->current()->loadFile(filePath);         //insert text into editor
+    setSpaceTabSelector();                          //the indentation may have been detected from the file
 }
 
-void MainWindow::saveFile(int index) {
-/* -save content to open file */
+void MainWindow::saveFile(int index, bool inBackground) {
+/*
+-save content to open file
+-unless `inBackground` is false, the file is written on a background thread (errors are shown on the status bar)
+*/
+    if ( editors->getEditor(index) == 0 ) return;                 // viewers can not change their file
+
     QString file = editors->getEditor(index)->getOpenFilePath();
 
     if ( file.isEmpty() ) {                                     // if no file is currently open, perform a 'save as' instead
@@ -410,45 +652,179 @@ void MainWindow::saveFile(int index) {
         return;
     }
 
-    ScintillaEditor* currentEditor = editors->getEditor(index);
-    if (ui->actionRemove_trailing_spaces_on_save->isChecked())  // remove trailing spaces if required
-        currentEditor->removeTrailingSpaces();
-    currentEditor->writeToFile(file, true);         // save changes and mark file as saved
+    ScintillaEditor* currentEditor = editors->getEditor(index)->documentOwner();   // other views of a document are saved by its owner
+    if ( currentEditor->isLoadDeferred() ) return;             // a file which was not loaded yet was not changed either
+    if ( currentEditor->isFollowing() ) return;                // a followed document can not be changed (and may be only the end of its file)
+    if ( !canWriteDocument(currentEditor) ) return;
+    int transforms = saveTransformsFor(currentEditor);          // cleanups applied to the text as it is saved
+    if (inBackground) currentEditor->saveInBackground(file, transforms);   // save changes; the file is marked as saved once it is written
+    else currentEditor->writeToFile(file, true, transforms);                // save changes and mark file as saved
 }
 
 void MainWindow::saveFileAs(int index) {
 /* -save content to a new file and load it */
+    if ( editors->getEditor(index) == 0 ) return;
+    ScintillaEditor* currentEditor = editors->getEditor(index)->documentOwner();
+    if ( !canWriteDocument(currentEditor) ) return;
+
     QString file = QFileDialog::getSaveFileName(this, tr("Save As"), getDialogDirPath() );  // get a new file name
     if ( file.isEmpty() ) return;                                                           // check if file name was actually specified
 
-    ScintillaEditor* currentEditor = editors->getEditor(index);
-    if (ui->actionRemove_trailing_spaces_on_save->isChecked())  // remove trailing spaces if required
-        currentEditor->removeTrailingSpaces();
-    currentEditor->writeToFile(file);
+    currentEditor->writeToFile(file, false, saveTransformsFor(currentEditor));
     currentEditor->loadFile(file);                  // open the newly created file
+    ui->actionFollow_File->setChecked(false);       // which is not followed
 }
 
 void MainWindow::saveFileCopyAs(int index) {
 /* -save a copy of content to a new file (new file not loaded) */
+    if ( editors->getEditor(index) == 0 ) return;
+    ScintillaEditor* currentEditor = editors->getEditor(index)->documentOwner();
+    if ( !canWriteDocument(currentEditor) ) return;
 
     QString file = QFileDialog::getSaveFileName(this, tr("Save Copy As"), getDialogDirPath() );
     if ( file.isEmpty() ) return;
 
-    ScintillaEditor* currentEditor = editors->getEditor(index);
-    if (ui->actionRemove_trailing_spaces_on_save->isChecked())
-        currentEditor->removeTrailingSpaces();
-    currentEditor->writeToFile(file);
+    currentEditor->writeToFile(file, false, saveTransformsFor(currentEditor));
+}
+
+bool MainWindow::canWriteDocument(ScintillaEditor* editor) {
+/*  -returns true if the document of `editor` can be written to a file, or tells why it can not on the status bar */
+    if ( editor->isLoading() || editor->isLoadDeferred() ) {    // a file which is not completely loaded must not be saved as if it were
+        ui->statusBar->showMessage(tr("%1 can not be saved until it is loaded.").arg(editor->getOpenFileName()), 5000);
+        return false;
+    }
+    return true;
+}
+
+bool MainWindow::loadDeferredTab(int index) {
+/*  -loads the file of a tab restored from the session, if it was not loaded yet (returns false if it could not be opened) */
+    ScintillaEditor* editor = editors->getEditor(index);
+    if ( editor == 0 || !editor->isLoadDeferred() ) return true;
+
+    const QString filePath = editor->getOpenFilePath();
+    if ( pendingPrefetches.contains(filePath) ) return true;       //the file is still being read, and is loaded once it was
+
+    //files read in the background were checked to be text; any other file may have to be shown in a viewer instead
+    PrefetchJob::Contents contents = prefetchedFiles.take(filePath);
+    QWidget* viewer = contents.loaded ? 0 : createViewerFor(filePath);
+    if (viewer != 0) {
+        editors->replaceTab(index, viewer, QFileInfo(filePath).fileName());
+        return true;
+    }
+    if ( editor->loadDeferredFile(&contents) ) return true;
+
+    editors->setTabText(index, "Untitled");     //the tab is left empty
+    return false;
+}
+
+QList<int> MainWindow::tabsByDistance() {
+/*  -returns the indices of the tabs, starting with the current one and then by increasing distance from it */
+    QList<int> indices;
+    const int current = editors->currentIndex();
+    if (current < 0) return indices;
+
+    indices.append(current);
+    for (int distance = 1, c = editors->count(); distance < c; distance++) {
+        if (current + distance < c) indices.append(current + distance);
+        if (current - distance >= 0) indices.append(current - distance);
+    }
+    return indices;
+}
+
+QWidget* MainWindow::createViewerFor(const QString& filePath) {
+/*  -returns a read-only viewer showing a file which can not be edited (ex. a binary file or a huge log), or null if it can be edited */
+
+    //only the start of the file is read to tell whether it is binary
+    QFile file(filePath);
+    if ( !file.open(QIODevice::ReadOnly) ) return 0;   //the editor reports why the file can not be opened
+    QByteArray start = file.read(65536);
+    qint64 fileSize = file.size();
+    file.close();
+
+    if ( TextEncoding::looksBinary(reinterpret_cast<const uchar*>( start.constData() ), start.size()) ) {
+        HexViewer* viewer = new HexViewer();
+        if ( !viewer->openFile(filePath) ) {
+            delete viewer;
+            return 0;
+        }
+        return viewer;
+    }
+
+    //text files too large for an editor are paged through instead of being loaded: besides the text itself, the lexer
+    //keeps a rule stack for every position of the document (ex. 8 GB for a 1 GiB file), so the default is 64 MiB, as for followed files
+    qint64 viewerThreshold = LeptonConfig::mainSettings->getValueOrDefault(67108864, "large_files", "viewer_threshold").toLongLong();
+    if (viewerThreshold <= 0 || viewerThreshold > INT_MAX) viewerThreshold = INT_MAX;
+    if (fileSize < viewerThreshold) return 0;
+
+    LargeFileViewer* viewer = new LargeFileViewer();
+    if ( !viewer->openFile(filePath) ) {
+        delete viewer;
+        return 0;
+    }
+    return viewer;
+}
+
+int MainWindow::saveTransformsFor(ScintillaEditor* editor) {
+/*  -returns the save transforms (see SaveTransforms) to apply to the text of `editor` when it is saved */
+    int transforms = SaveTransforms::forLanguage( editor->getLanguageName() );
+    if ( ui->actionRemove_trailing_spaces_on_save->isChecked() ) transforms |= SaveTransforms::StripTrailingSpaces;
+    return transforms;
+}
+
+void MainWindow::recoverUnsavedChanges() {
+/*  -offers to recover the changes journaled by instances of Lepton which did not exit cleanly */
+    QList<EditJournal::Recovery> journals = EditJournal::orphanedJournals();
+    if ( journals.isEmpty() ) return;
+
+    QMessageBox::StandardButton answer = QMessageBox::question(this, tr("Lepton Editor"),
+            tr("Lepton Editor was not closed properly.  Recover the unsaved changes made to %n document(s)?", 0, journals.count()),
+            QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+    if (answer != QMessageBox::Yes) return;     //the journals were already removed
+
+    foreach (const EditJournal::Recovery& recovery, journals) {
+        //the changes are only valid on top of the file they were made to
+        if ( !recovery.filePath.isEmpty() ) {
+            QFileInfo file(recovery.filePath);
+            if ( !file.exists() ) {
+                QMessageBox::warning(this, tr("Lepton Error"), tr("The unsaved changes to %1 can not be recovered: the file no longer exists.").arg(recovery.filePath));
+                continue;
+            }
+            if ( file.size() != recovery.baseSize || file.lastModified() != recovery.baseModified ) {
+                answer = QMessageBox::question(this, tr("Lepton Editor"),
+                        tr("%1 was changed since its unsaved changes were made, so they may not be recovered correctly.  Recover them anyway?").arg(recovery.filePath),
+                        QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+                if (answer != QMessageBox::Yes) continue;
+            }
+        }
+
+        //the changes are applied to the tab showing the file, or to a new one
+        int index = -1;
+        for (int i = 0; i < editors->count() && index < 0 && !recovery.filePath.isEmpty(); i++) {
+            if ( editors->getEditor(i) != 0 && QFileInfo(editors->getEditor(i)->getOpenFilePath()) == QFileInfo(recovery.filePath) ) index = i;
+        }
+        if (index < 0) {
+            if ( recovery.filePath.isEmpty() ) index = insertTab();
+            else {
+                openFile(recovery.filePath);
+                index = editors->currentIndex();
+            }
+        }
+        if ( editors->getEditor(index) != 0 ) editors->getEditor(index)->recoverChanges(recovery);
+    }
 }
 
 void MainWindow::setLanguageSelectorMenu() {
 /* -set the language selector menu from editor object */
-    if ( editors->count() < 1 ) return;
+    LargeFileViewer* viewer = qobject_cast<LargeFileViewer*>( editors->currentWidget() );
+    ui->menuLanguage->menuAction()->setEnabled( editors->current() != 0 || viewer != 0 );    //hex viewers are not highlighted
+    if (viewer != 0) ui->menuLanguage->menuAction()->setMenu( viewer->getLanguageMenu() );
+    if ( editors->current() == 0 ) return;
     ui->menuLanguage->menuAction()->setMenu( editors->current()->getLanguageMenu() );
 }
 
 void MainWindow::setSpaceTabSelector() {
 /*  -set the space/tab selector to match the state of the current editor tab */
-    if ( editors->count() < 1) return;
+    if ( editors->current() == 0 ) return;
 
     if ( editors->current()->indentationsUseTabs() ) ui->actionUse_Tabs->setChecked(true);
     else ui->actionUse_Spaces->setChecked(true);
@@ -462,7 +838,9 @@ QString MainWindow::getDialogDirPath(const QString& location) {
 */
     QString path;
 
-    if (location == "home" || (! editors->current()->isFileOpen()) ) {
+    QString openFilePath = editors->currentIndex() >= 0 ? editors->filePathAt( editors->currentIndex() ) : QString();
+
+    if (location == "home" || ! QFileInfo(openFilePath).exists() ) {
 #ifdef QT_DEBUG
         path = QDir::currentPath(); //use the executable's directory
 #else
@@ -470,7 +848,7 @@ QString MainWindow::getDialogDirPath(const QString& location) {
 #endif
     }
     else {
-        path = editors->current()->getOpenFileDir();    //get the directory of the file being edited in the current tab
+        path = QFileInfo(openFilePath).absolutePath();  //get the directory of the file being edited in the current tab
     }
 
     return path;
@@ -483,5 +861,8 @@ int MainWindow::insertTab() {
     int index = editors->addTab();
     ScintillaEditor* newEditor = dynamic_cast<ScintillaEditor*>(editors->widget(index));
     connect(newEditor, SIGNAL(cursorPositionChanged(int,int)), this, SLOT(updateStatusLabel()));
+    connect(newEditor, SIGNAL(loadProgress(qint64,qint64)), this, SLOT(updateLoadProgress()));
+    connect(newEditor, SIGNAL(loadFinished()), this, SLOT(updateLoadProgress()));
+    connect(newEditor, SIGNAL(saveFailed(QString,QString)), this, SLOT(showSaveError(QString,QString)));
     return index;
 }
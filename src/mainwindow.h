@@ -41,12 +41,19 @@ Usage Agreement:
 #include <QPoint>
 #include <QModelIndex>
 #include <QString>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
 
 #include "editortabbar.h"
 #include "projectlistmodel.h"
 #include "settingseditor.h"
 #include "findreplacedialog.h"
 #include "sessionmanager.h"
+#include "lexerprofilerpanel.h"
+#include "prefetchjob.h"
 
 namespace Ui {
     class MainWindow;
@@ -93,6 +100,12 @@ class MainWindow : public QMainWindow {
         void on_actionSave_All_triggered();
         /* -save changes to all documents */
 
+        void on_actionNew_View_triggered();
+        /*  -opens another tab showing the document in the current tab */
+
+        void on_actionFollow_File_triggered(bool follow);
+        /*  -turns follow mode (showing text appended to the file, ex. a log) on or off for the current tab file */
+
         void editTabChanged();
         /* -called when visible tab is changed to update main window */
 
@@ -138,6 +151,9 @@ class MainWindow : public QMainWindow {
         void findNextInCurrent();
         /*  -called to perform a "find next" on the current tab file (should be called after `findInCurrent()` ) */
 
+        void on_actionGo_to_Line_triggered();
+        /*  -called to go to a line of the current tab file */
+
         void replaceInCurrent(const FindReplaceDialog::DialogParameters& parameters);
         /*  -called to perform a "replace" on the current tab file using the data in `parameters` */
 
@@ -147,6 +163,21 @@ class MainWindow : public QMainWindow {
         void updateStatusLabel();
         /*  update the status bar label */
 
+        void updateLoadProgress();
+        /*  -shows the progress of the file being loaded in the current tab (if any) on the status bar */
+
+        void cancelFileLoad();
+        /*  -stops loading the file being loaded in the current tab */
+
+        void showSaveError(const QString& filePath, const QString& errorString);
+        /*  -reports that a file saved in the background could not be written (without blocking other saves) */
+
+        void prefetchDeferredTab();
+        /*  -loads the file of one of the tabs restored from the session which were not shown yet */
+
+        void filePrefetched(const PrefetchJob::Contents& contents);
+        /*  -called when the file of a tab restored from the session was read in the background */
+
         void loadSession();
         /* -load settings and configs from saved session */
 
@@ -165,13 +196,34 @@ class MainWindow : public QMainWindow {
         FindReplaceDialog  findReplace; // a dialog used to do find/replace tasks
         QLabel* statusLabel;            // the message shown on the status bar
         QString statusLabelTemplate;    // holds the template used to generate the status bar message
+        QProgressBar* loadProgressBar;  // shows how much of the file in the current tab has been loaded
+        QPushButton* cancelLoadButton;  // button used to stop loading the file in the current tab
         SessionManager sessionManager;
+        LexerProfilerPanel* profilerPanel;  // panel displaying the statistics collected by the lexer profiler
+        QTimer prefetchTimer;           // timer used to load the files of restored tabs while the editor is idle
+        QSet< QString > pendingPrefetches;  // files of restored tabs which are being read in the background
+        QHash< QString, PrefetchJob::Contents > prefetchedFiles;   // files of restored tabs which were read, but not loaded into their tab yet
 
         void openFile(const QString& filePath);
         /* -opens a specified file in an editor tab */
 
-        void saveFile(int index);
-        /* -save content to open file */
+        bool loadDeferredTab(int index);
+        /*
+            -loads the file of a tab restored from the session, if it was not loaded yet (returns false if it could not be opened)
+            -if the file is still being read in the background, the tab is loaded once it was read
+        */
+
+        QWidget* createViewerFor(const QString& filePath);
+        /*  -returns a read-only viewer showing a file which can not be edited (ex. a binary file), or null if it can be edited */
+
+        QList<int> tabsByDistance();
+        /*  -returns the indices of the tabs, starting with the current one and then by increasing distance from it */
+
+        void saveFile(int index, bool inBackground = true);
+        /*
+            -save content to open file
+            -unless `inBackground` is false, the file is written on a background thread (errors are shown on the status bar)
+        */
 
         void saveFileAs(int index);
         /* -save content to a new file and load it */
@@ -179,6 +231,15 @@ class MainWindow : public QMainWindow {
         void saveFileCopyAs(int index);
         /* -save a copy of content to a new file (new file not loaded) */
 
+        bool canWriteDocument(ScintillaEditor* editor);
+        /*  -returns true if the document of `editor` can be written to a file, or tells why it can not on the status bar */
+
+        void recoverUnsavedChanges();
+        /*  -offers to recover the changes journaled by instances of Lepton which did not exit cleanly */
+
+        int saveTransformsFor(ScintillaEditor* editor);
+        /*  -returns the save transforms (see SaveTransforms) to apply to the text of `editor` when it is saved */
+
         void setLanguageSelectorMenu();
         /* -set the language selector menu from editor object */
 
@@ -0,0 +1,121 @@
+/*
+Project: Lepton Editor
+File: mappedfile.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the MappedFile class.  It maps a file into
+    memory one window at a time.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "mappedfile.h"
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+MappedFile::MappedFile() : fileSize(0), window(0), windowStart(0), windowLength(0) {
+/*  -Class constructor */
+}
+
+MappedFile::~MappedFile() {
+/*  -Class destructor (unmaps and closes the file) */
+    close();
+}
+
+bool MappedFile::open(const QString& filePath) {
+/*  -opens a file to be mapped; returns false if it can not be opened (see `errorString()`) */
+    close();
+    file.setFileName(filePath);
+    if ( !file.open(QIODevice::ReadOnly) ) return false;
+    fileSize = file.size();
+    return true;
+}
+
+void MappedFile::close() {
+/*  -unmaps and closes the file */
+    unmapWindow();
+    file.close();
+    fileSize = 0;
+}
+
+QString MappedFile::errorString() const {
+/*  -returns a description of the last error */
+    return file.errorString();
+}
+
+qint64 MappedFile::size() const {
+/*  -returns the size of the file (when it was opened) */
+    return fileSize;
+}
+
+const uchar* MappedFile::map(qint64 offset, qint64 length) {
+/*
+-returns a pointer to the `length` bytes of the file starting at `offset` (which must be within the file),
+ or null if they can not be mapped
+-`length` is cut short at the end of the file
+*/
+
+    /*######################################################################################
+    ### Only the pages of a mapping which are touched are read from the disk, so mapping  ##
+    ### the file costs nothing until it is looked at.  Still, a whole file of several     ##
+    ### gigabytes may not fit in the address space (ex. of a 32-bit process), so it is    ##
+    ### mapped a window at a time.  Windows start on a multiple of 64KiB, which is a      ##
+    ### valid offset for a mapping on every platform, and are only replaced when a range  ##
+    ### outside of the current one is asked for.                                          ##
+    ######################################################################################*/
+
+    if (offset < 0 || offset >= fileSize || length <= 0) return 0;
+    length = qMin(length, fileSize - offset);
+
+    if ( window == 0 || offset < windowStart || offset + length > windowStart + windowLength ) {
+        unmapWindow();
+        const qint64 start = offset & ~qint64(65535);
+        const qint64 end = qMin(fileSize, qMax(start + windowSize, offset + length));
+        window = file.map(start, end - start);
+        if (window == 0) return 0;
+        windowStart = start;
+        windowLength = end - start;
+    }
+
+    return window + (offset - windowStart);
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void MappedFile::unmapWindow() {
+/*  -unmaps the window of the file which is mapped (if any) */
+    if (window != 0) file.unmap(window);
+    window = 0;
+    windowStart = 0;
+    windowLength = 0;
+}
@@ -0,0 +1,92 @@
+/*
+Project: Lepton Editor
+File: mappedfile.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the MappedFile class.  It gives access to the
+    contents of a file of any size by mapping it into memory one window at a time, so that
+    only the parts of the file which are used are ever read, and only a window of it is
+    mapped at once.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+//include Qt classes
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+
+
+class MappedFile {
+/*
+-A class that maps a (read-only) file into memory one window at a time.
+-A pointer returned by `map()` is only valid until the next call to `map()` or `close()`.
+*/
+
+    public:
+        MappedFile();
+        /*  -Class constructor */
+
+        ~MappedFile();
+        /*  -Class destructor (unmaps and closes the file) */
+
+        bool open(const QString& filePath);
+        /*  -opens a file to be mapped; returns false if it can not be opened (see `errorString()`) */
+
+        void close();
+        /*  -unmaps and closes the file */
+
+        QString errorString() const;
+        /*  -returns a description of the last error */
+
+        qint64 size() const;
+        /*  -returns the size of the file (when it was opened) */
+
+        const uchar* map(qint64 offset, qint64 length);
+        /*
+            -returns a pointer to the `length` bytes of the file starting at `offset` (which must be within the file),
+             or null if they can not be mapped
+            -`length` is cut short at the end of the file
+        */
+
+        static const qint64 windowSize = 4194304;   //smallest amount of the file mapped at once
+
+    private:
+        QFile file;             //file being mapped
+        qint64 fileSize;        //size of the file when it was opened
+        uchar* window;          //memory the mapped window of the file starts at (null if nothing is mapped)
+        qint64 windowStart;     //offset of the mapped window in the file
+        qint64 windowLength;    //length of the mapped window
+
+        void unmapWindow();
+        /*  -unmaps the window of the file which is mapped (if any) */
+};
+
+#endif // MAPPEDFILE_H
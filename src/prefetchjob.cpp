@@ -0,0 +1,154 @@
+/*
+Project: Lepton Editor
+File: prefetchjob.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the PrefetchJob class.  It reads a file on a
+    background thread and prepares its text to be handed to an editor.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "prefetchjob.h"
+
+//include Qt classes
+#include <QFile>
+#include <QFileInfo>
+#include <QTextDecoder>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include other standard library classes
+#include <climits>
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static int longestLineIn(const char* text, int length) {
+/*  -returns the length of the longest line of the `length` bytes at `text` (lines may end with "\n", "\r\n" or "\r") */
+    int longest = 0;
+    int lineStart = 0;
+    for (int i = 0; i < length; i++) {
+        if (text[i] != '\n' && text[i] != '\r') continue;
+        longest = qMax(longest, i - lineStart);
+        if (text[i] == '\r' && i + 1 < length && text[i + 1] == '\n') i++;
+        lineStart = i + 1;
+    }
+    return qMax(longest, length - lineStart);
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+PrefetchJob::PrefetchJob(const QString& _filePath) : filePath(_filePath) {
+/*  -Class constructor (must be called from the main thread) */
+    qint64 streamingThreshold = LeptonConfig::mainSettings->getValueOrDefault(8388608, "large_files", "streaming_load_threshold").toLongLong();
+    maxSize = streamingThreshold > 0 ? qMin(streamingThreshold, qint64(INT_MAX) - 1) : qint64(INT_MAX) - 1;
+    qRegisterMetaType<PrefetchJob::Contents>("PrefetchJob::Contents");
+
+    //the job is deleted by the thread it belongs to, once its result was delivered, instead of by the pool
+    setAutoDelete(false);
+    connect(this, SIGNAL(finished(PrefetchJob::Contents)), this, SLOT(deleteLater()));
+}
+
+void PrefetchJob::run() {
+/*  -reads the file and emits `finished()` (called on a thread of the pool) */
+
+    /*########################################################################################
+    ### Everything which only depends on the file is done here, so the main thread only    ##
+    ### has to copy the text into the editor.  The time stamp of the file is taken before  ##
+    ### it is read: if the file changes while (or after) it is read, the editor sees that  ##
+    ### its file is newer than its text, and reloads it.                                    ##
+    ########################################################################################*/
+
+    Contents contents;
+    contents.filePath = filePath;
+
+    QFile file(filePath);
+    QFileInfo info(filePath);
+    if ( !file.open(QIODevice::ReadOnly) || file.size() > maxSize ) {
+        emit finished(contents);    //the editor loads the file itself (and reports why it can not be opened, if it can not)
+        return;
+    }
+    contents.lastModified = info.lastModified();
+    contents.size = info.size();
+
+    QByteArray bytes = file.readAll();
+    if ( file.error() != QFileDevice::NoError ) {
+        emit finished(contents);
+        return;
+    }
+    file.close();
+
+    //binary files are not converted; they are shown in a viewer instead of being loaded into the editor
+    const uchar* data = reinterpret_cast<const uchar*>( bytes.constData() );
+    if ( TextEncoding::looksBinary(data, qMin(bytes.size(), 65536)) ) {
+        emit finished(contents);
+        return;
+    }
+    contents.format = TextEncoding::detect(data, bytes.size());
+    const int bomLength = contents.format.hasBom ? TextEncoding::byteOrderMark(contents.format.encoding).size() : 0;
+
+    if (contents.format.encoding == TextEncoding::Utf8) {
+        if (bomLength > 0) bytes.remove(0, bomLength);
+        contents.text = bytes;
+    }
+    else {
+        //the text is converted in blocks so that the whole file is never held as UTF-16 at once
+        QTextDecoder decoder( TextEncoding::codecFor(contents.format.encoding), QTextCodec::IgnoreHeader );
+        const int blockSize = 1048576;
+        for (int i = bomLength; i < bytes.size(); i += blockSize) {
+            contents.text.append( decoder.toUnicode(bytes.constData() + i, qMin(blockSize, bytes.size() - i)).toUtf8() );
+        }
+    }
+
+    contents.longestLine = longestLineIn(contents.text.constData(), contents.text.size());
+    contents.loaded = true;
+    emit finished(contents);
+}
+
+QThreadPool* PrefetchJob::threadPool() {
+/*  -returns the pool of threads on which files are read */
+
+    /*#####################################################################################
+    ### Reading many files from a cold cache (or a network drive) is mostly waiting, so  ##
+    ### several files are read at once to keep the disk busy.  The pool is separate from ##
+    ### the one files are saved on, so reads never wait behind writes.                   ##
+    #####################################################################################*/
+
+    static QThreadPool* pool = 0;
+    if (pool == 0) {
+        pool = new QThreadPool();
+        pool->setMaxThreadCount( LeptonConfig::mainSettings->getValueOrDefault(8, "session", "io_threads").toInt() );
+    }
+    return pool;
+}
@@ -0,0 +1,95 @@
+/*
+Project: Lepton Editor
+File: prefetchjob.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the PrefetchJob class.  It reads a file on a
+    background thread, detects its encoding and converts it to UTF-8, so that many files
+    (ex. the ones of a restored session) can be read at once and only need to be handed
+    to their editors on the main thread.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PREFETCHJOB_H
+#define PREFETCHJOB_H
+
+//include Qt classes
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+#include <QMetaType>
+
+//include Lepton files which are needed by this class
+#include "textencoding.h"
+
+
+
+class PrefetchJob : public QObject, public QRunnable {
+/*
+-A class that reads a file on a thread of `threadPool()`.
+-The job is deleted (from the thread it was created in) after `finished()` is emitted.
+*/
+
+    Q_OBJECT
+
+    public:
+        struct Contents {
+                QString filePath;               //path to the file read
+                bool loaded;                    //false if the file was not read (it could not be, it is binary or it is large enough to be loaded progressively)
+                TextEncoding::Format format;    //encoding of the file
+                QByteArray text;                //contents of the file, converted to UTF-8 (without a byte order mark)
+                int longestLine;                //length of the longest line of the text
+                QDateTime lastModified;         //last modification time of the file when it was read
+                qint64 size;                    //size of the file when it was read
+
+                Contents() : loaded(false), longestLine(0), size(-1) {}
+        };
+
+        explicit PrefetchJob(const QString& _filePath);
+        /*  -Class constructor (must be called from the main thread) */
+
+        void run();
+        /*  -reads the file and emits `finished()` (called on a thread of the pool) */
+
+        static QThreadPool* threadPool();
+        /*  -returns the pool of threads on which files are read */
+
+    signals:
+        void finished(const PrefetchJob::Contents& contents);
+        /*  -emitted when the file was read (or could not be) */
+
+    private:
+        QString filePath;   //path to the file being read
+        qint64 maxSize;     //size above which the file is not read (since it is loaded progressively instead)
+};
+
+Q_DECLARE_METATYPE(PrefetchJob::Contents)
+
+#endif // PREFETCHJOB_H
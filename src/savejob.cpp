@@ -0,0 +1,168 @@
+/*
+Project: Lepton Editor
+File: savejob.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the SaveJob class.  It writes a snapshot of a
+    document to a file on a background thread, so that saving (especially several files
+    at once, or to a slow network drive) does not block the user interface.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "savejob.h"
+
+//include Qt classes
+#include <QSaveFile>
+#include <QFile>
+#include <QFileInfo>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include system headers
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static void syncDirectoryAt(const QString& dirPath) {
+/*  -flushes the entries of a directory (ex. a file renamed into it) to disk, where this is supported */
+#ifdef Q_OS_UNIX
+    int fd = ::open(QFile::encodeName(dirPath).constData(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+#else
+    Q_UNUSED(dirPath);
+#endif
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+SaveJob::SaveJob(const QString& _filePath, const QByteArray& _data, const TextEncoding::Format& _format, const SaveTransforms::Options& _options)
+    : filePath(_filePath), data(_data), format(_format), options(_options) {
+/*
+-Class constructor (must be called from the main thread)
+-`_data` is a snapshot of the (UTF-8) document being saved, which is transformed as set by `_options`
+ and written in the encoding `_format`
+*/
+    syncDirectory = syncDirectoryOnSave();
+    qRegisterMetaType<SaveTransforms::EditList>("SaveTransforms::EditList");
+
+    //the job is deleted by the thread it belongs to, once its result was delivered, instead of by the pool
+    setAutoDelete(false);
+    connect(this, SIGNAL(finished(QString,bool,QString)), this, SLOT(deleteLater()));
+}
+
+void SaveJob::run() {
+/*  -transforms and writes the data to the file, and emits `finished()` (called on a thread of the pool) */
+    SaveTransforms::EditList edits;
+    if (options.transforms != 0) {
+        QByteArray transformedData;
+        edits = SaveTransforms::apply(data.constData(), data.size(), options, &transformedData);
+        if ( !edits.isEmpty() ) data = transformedData;
+    }
+
+    //text which can not be represented in the file's encoding is written as UTF-8 instead of being lost
+    bool savedAsUtf8 = false;
+    if (! format.isUtf8() ) {
+        bool lossless = true;
+        QByteArray encoded = TextEncoding::fromUtf8(data.constData(), data.size(), format, &lossless);
+        if (lossless) data = encoded;
+        else savedAsUtf8 = true;
+    }
+
+    if ( !edits.isEmpty() || savedAsUtf8 ) emit transformed(edits, savedAsUtf8);
+
+    QString errorString;
+    bool succeeded = writeFile(filePath, data.constData(), data.size(), syncDirectory, &errorString);
+    data.clear();   //the snapshot is not needed anymore
+    emit finished(filePath, succeeded, errorString);
+}
+
+QThreadPool* SaveJob::threadPool() {
+/*  -returns the pool of threads on which files are written */
+
+    /*######################################################################################
+    ### Writing files is mostly waiting on the disk (or the network), not using the CPU,  ##
+    ### so files are written on a pool of their own which does not compete with (or wait ##
+    ### behind) other work done in the background.                                        ##
+    ######################################################################################*/
+
+    static QThreadPool* pool = 0;
+    if (pool == 0) {
+        pool = new QThreadPool();
+        pool->setMaxThreadCount( LeptonConfig::mainSettings->getValueOrDefault(4, "saving", "io_threads").toInt() );
+    }
+    return pool;
+}
+
+bool SaveJob::writeFile(const QString& filePath, const char* data, qint64 length, bool syncDirectory, QString* errorString) {
+/*
+-atomically replaces the contents of the file at `filePath` with the `length` bytes at `data`
+-if `syncDirectory` is true, the directory of the file is synced too, so that the replacement is durable
+-returns true if the file was written; otherwise returns false and sets `errorString` (if given)
+*/
+
+    /*##########################################################################################
+    ### The data is written to a temporary file which only replaces the file being saved once ##
+    ### it was completely written (and synced to disk), so a crash while saving never leaves  ##
+    ### a truncated file behind.                                                              ##
+    ##########################################################################################*/
+
+    QSaveFile file(filePath);
+
+    if ( !file.open(QIODevice::WriteOnly) ) {
+        if (errorString != 0) *errorString = file.errorString();
+        return false;
+    }
+
+    if ( file.write(data, length) != length || !file.commit() ) {
+        if (errorString != 0) *errorString = file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    //the file is synced by `commit()`, but the rename which replaced it is only durable once its directory is synced too
+    if (syncDirectory) syncDirectoryAt( QFileInfo(filePath).absolutePath() );
+
+    return true;
+}
+
+bool SaveJob::syncDirectoryOnSave() {
+/*  -returns true if the fsync policy asks for directories to be synced after saving (must be called from the main thread) */
+    return LeptonConfig::mainSettings->getValueOrDefault("file", "saving", "fsync_policy").toString() == "full";
+}
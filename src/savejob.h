@@ -0,0 +1,107 @@
+/*
+Project: Lepton Editor
+File: savejob.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the SaveJob class.  It writes a snapshot of a
+    document to a file on a background thread, so that saving (especially several files
+    at once, or to a slow network drive) does not block the user interface.  The save
+    transforms of the document and its conversion to the file's encoding are done on that
+    thread too.  It also provides the function used to write files atomically, whether in
+    the background or not.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SAVEJOB_H
+#define SAVEJOB_H
+
+//include Qt classes
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QString>
+#include <QByteArray>
+
+//include Lepton files which are needed by this class
+#include "savetransforms.h"
+#include "textencoding.h"
+
+
+
+class SaveJob : public QObject, public QRunnable {
+/*
+-A class that writes data to a file on a thread of `threadPool()`.
+-The job is deleted (from the thread it was created in) after `finished()` is emitted.
+*/
+
+    Q_OBJECT
+
+    public:
+        SaveJob(const QString& _filePath, const QByteArray& _data, const TextEncoding::Format& _format = TextEncoding::Format(),
+                const SaveTransforms::Options& _options = SaveTransforms::Options());
+        /*
+            -Class constructor (must be called from the main thread)
+            -`_data` is a snapshot of the (UTF-8) document being saved, which is transformed as set by `_options`
+             and written in the encoding `_format`
+        */
+
+        void run();
+        /*  -transforms and writes the data to the file, and emits `finished()` (called on a thread of the pool) */
+
+        static QThreadPool* threadPool();
+        /*  -returns the pool of threads on which files are written */
+
+        static bool writeFile(const QString& filePath, const char* data, qint64 length, bool syncDirectory, QString* errorString = 0);
+        /*
+            -atomically replaces the contents of the file at `filePath` with the `length` bytes at `data`
+            -if `syncDirectory` is true, the directory of the file is synced too, so that the replacement is durable
+            -returns true if the file was written; otherwise returns false and sets `errorString` (if given)
+        */
+
+        static bool syncDirectoryOnSave();
+        /*  -returns true if the fsync policy asks for directories to be synced after saving (must be called from the main thread) */
+
+    signals:
+        void transformed(const SaveTransforms::EditList& edits, bool savedAsUtf8);
+        /*
+            -emitted (before `finished()`) if the save transforms changed the text, or if it could not be represented
+             in its encoding and was written as UTF-8 instead
+            -`edits` are the changes made to the snapshot
+        */
+
+        void finished(const QString& filePath, bool succeeded, const QString& errorString);
+        /*  -emitted when the file was written (or could not be) */
+
+    private:
+        QString filePath;                   //path to the file being written
+        QByteArray data;                    //data written to the file
+        TextEncoding::Format format;        //encoding the data is written in
+        SaveTransforms::Options options;    //transforms applied to the data before it is written
+        bool syncDirectory;                 //true if the directory of the file should be synced after it is written
+};
+
+#endif // SAVEJOB_H
@@ -0,0 +1,187 @@
+/*
+Project: Lepton Editor
+File: savetransforms.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the SaveTransforms class.  It applies the cleanups
+    configured for a language to a document being saved, in a single pass over its text.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "savetransforms.h"
+
+//include Qt classes
+#include <QStringList>
+#include <QVariant>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+
+//include other standard library classes
+#include <cstring>
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static int lineEndFrom(const char* text, int from, int length) {
+/*  -returns the position of the first line ending ("\n" or "\r") at or after `from` (`length` if there is none) */
+
+    //`memchr()` compares many bytes at a time; carriage returns are only searched for within the line found
+    const char* newline = reinterpret_cast<const char*>( std::memchr(text + from, '\n', length - from) );
+    const int end = newline != 0 ? int(newline - text) : length;
+    const char* carriageReturn = reinterpret_cast<const char*>( std::memchr(text + from, '\r', end - from) );
+    return carriageReturn != 0 ? int(carriageReturn - text) : end;
+}
+
+static void addEdit(SaveTransforms::EditList& edits, QByteArray* result, const char* text, int& copiedLength,
+                    int position, int length, const QByteArray& replacement) {
+/*
+-adds an edit replacing the `length` bytes at `position` with `replacement` to `edits`
+-if `result` is given, the text up to the edit and its replacement are added to it (`copiedLength` is the length of
+ the text already copied or replaced)
+*/
+    SaveTransforms::Edit edit;
+    edit.position = position;
+    edit.length = length;
+    edit.text = replacement;
+    edits.append(edit);
+
+    if (result != 0) {
+        result->append(text + copiedLength, position - copiedLength);
+        result->append(replacement);
+    }
+    copiedLength = position + length;
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int SaveTransforms::forLanguage(const QString& language) {
+/*  -returns the transforms configured for `language`, or the default ones if it has none (must be called from the main thread) */
+    QVariant names = LeptonConfig::mainSettings->getValue("save_transforms", language);
+    if ( names.isNull() ) names = LeptonConfig::mainSettings->getValue("save_transforms", "default");
+
+    int transforms = 0;
+    foreach (const QString& name, names.toStringList()) {
+        if (name == "strip_trailing_spaces") transforms |= StripTrailingSpaces;
+        else if (name == "final_newline") transforms |= EnsureFinalNewline;
+        else if (name == "normalize_eol") transforms |= NormalizeEol;
+        else if (name == "normalize_indentation") transforms |= NormalizeIndentation;
+    }
+    return transforms;
+}
+
+SaveTransforms::EditList SaveTransforms::apply(const char* text, int length, const Options& options, QByteArray* result) {
+/*
+-returns the edits, in increasing order of position, which apply the transforms in `options` to the `length` bytes
+ of UTF-8 text at `text`
+-if `result` is given, it is set to the transformed text
+*/
+
+    /*##########################################################################################
+    ### All the transforms are applied to a line before moving on to the next, so the text is ##
+    ### only traversed once however many transforms are configured.  Each transform only     ##
+    ### looks at the start or the end of a line, and the edits of a line never overlap, so    ##
+    ### they come out in order of position.  The transformed text (if asked for) is built as  ##
+    ### the edits are found, by copying the text between them.                                ##
+    ##########################################################################################*/
+
+    EditList edits;
+    int copiedLength = 0;
+    if (result != 0) {
+        result->clear();
+        result->reserve(length + options.eol.size());
+    }
+
+    const bool strip = options.transforms & StripTrailingSpaces;
+    const bool indent = options.transforms & NormalizeIndentation;
+    const int tabWidth = qMax(options.tabWidth, 1);
+    int modifiedIndex = 0;  //index in `options.modifiedLines` of the first line which was not passed yet
+
+    for (int line = 0, lineStart = 0; ; line++) {
+        const int contentEnd = lineEndFrom(text, lineStart, length);
+        int eolLength = 0;
+        if (contentEnd < length) eolLength = (text[contentEnd] == '\r' && contentEnd + 1 < length && text[contentEnd + 1] == '\n') ? 2 : 1;
+
+        bool lineSelected = true;
+        if (options.onlyModifiedLines) {
+            while (modifiedIndex < options.modifiedLines.size() && options.modifiedLines.at(modifiedIndex) < line) modifiedIndex++;
+            lineSelected = modifiedIndex < options.modifiedLines.size() && options.modifiedLines.at(modifiedIndex) == line;
+        }
+
+        bool lineBlank = contentEnd == lineStart;   //true if the line is (or is made) empty
+        if ( lineSelected && (strip || indent) ) {
+            int indentEnd = lineStart;
+            while (indentEnd < contentEnd && (text[indentEnd] == ' ' || text[indentEnd] == '\t')) indentEnd++;
+
+            if (indentEnd == contentEnd) {
+                //a line of white space has nothing to indent, so it is only stripped
+                if (strip && contentEnd > lineStart) {
+                    addEdit(edits, result, text, copiedLength, lineStart, contentEnd - lineStart, QByteArray());
+                    lineBlank = true;
+                }
+            }
+            else {
+                if (indent) {
+                    int column = 0;
+                    for (int i = lineStart; i < indentEnd; i++) column = text[i] == '\t' ? (column / tabWidth + 1) * tabWidth : column + 1;
+
+                    QByteArray indentation;
+                    if (options.indentUseTabs) indentation = QByteArray(column / tabWidth, '\t') + QByteArray(column % tabWidth, ' ');
+                    else indentation = QByteArray(column, ' ');
+
+                    if ( indentation.size() != indentEnd - lineStart || std::memcmp(indentation.constData(), text + lineStart, indentation.size()) != 0 )
+                        addEdit(edits, result, text, copiedLength, lineStart, indentEnd - lineStart, indentation);
+                }
+                if (strip) {
+                    int spacesStart = contentEnd;
+                    while (spacesStart > indentEnd && (text[spacesStart - 1] == ' ' || text[spacesStart - 1] == '\t')) spacesStart--;
+                    if (spacesStart < contentEnd) addEdit(edits, result, text, copiedLength, spacesStart, contentEnd - spacesStart, QByteArray());
+                }
+            }
+        }
+
+        if (eolLength == 0) {
+            //a final newline is not added after an empty last line, since the line before it already ends with one
+            if ( (options.transforms & EnsureFinalNewline) && !lineBlank ) addEdit(edits, result, text, copiedLength, length, 0, options.eol);
+            break;
+        }
+
+        if ( (options.transforms & NormalizeEol) && (eolLength != options.eol.size() || std::memcmp(text + contentEnd, options.eol.constData(), eolLength) != 0) )
+            addEdit(edits, result, text, copiedLength, contentEnd, eolLength, options.eol);
+
+        lineStart = contentEnd + eolLength;
+    }
+
+    if (result != 0) result->append(text + copiedLength, length - copiedLength);
+    return edits;
+}
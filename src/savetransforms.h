@@ -0,0 +1,94 @@
+/*
+Project: Lepton Editor
+File: savetransforms.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the SaveTransforms class.  It applies the cleanups
+    configured for a language (ex. removing trailing spaces or adding a final newline) to a
+    document being saved, in a single pass over its text, and returns them as a list of edits
+    which can be applied to the editor.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SAVETRANSFORMS_H
+#define SAVETRANSFORMS_H
+
+//include Qt classes
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QMetaType>
+
+
+
+class SaveTransforms {
+/*
+-A class that applies the transforms configured for a language to text being saved.
+-The configuration (the "save_transforms" section of the main config file) maps language names (or "default")
+ to lists of transform names: "strip_trailing_spaces", "final_newline", "normalize_eol" and "normalize_indentation".
+*/
+
+    public:
+        enum Transform {
+            StripTrailingSpaces = 0x1,      //remove the spaces and tabs at the end of lines
+            EnsureFinalNewline = 0x2,       //end the last line with a line ending
+            NormalizeEol = 0x4,             //end every line with the same line ending
+            NormalizeIndentation = 0x8      //indent lines only with tabs (and spaces up to the column) or only with spaces
+        };
+
+        struct Options {
+                int transforms;             //transforms to apply (a combination of `Transform` flags)
+                QByteArray eol;             //line ending used by `NormalizeEol` and `EnsureFinalNewline`
+                bool indentUseTabs;         //true if `NormalizeIndentation` indents with tabs
+                int tabWidth;               //number of columns of a tab
+                bool onlyModifiedLines;     //if true, only lines listed in `modifiedLines` are stripped or re-indented
+                QVector<int> modifiedLines; //numbers of the lines which were modified, in increasing order
+
+                Options() : transforms(0), eol("\n"), indentUseTabs(false), tabWidth(4), onlyModifiedLines(false) {}
+        };
+
+        struct Edit {
+                int position;       //position of the text replaced
+                int length;         //length of the text replaced
+                QByteArray text;    //text replacing it
+        };
+        typedef QVector<Edit> EditList;
+
+        static int forLanguage(const QString& language);
+        /*  -returns the transforms configured for `language`, or the default ones if it has none (must be called from the main thread) */
+
+        static EditList apply(const char* text, int length, const Options& options, QByteArray* result = 0);
+        /*
+            -returns the edits, in increasing order of position, which apply the transforms in `options` to the `length` bytes
+             of UTF-8 text at `text`
+            -if `result` is given, it is set to the transformed text
+        */
+};
+
+Q_DECLARE_METATYPE(SaveTransforms::EditList)
+
+#endif // SAVETRANSFORMS_H
@@ -42,13 +42,108 @@ Usage Agreement:
 #include <QMessageBox>
 #include <Qsci/qscilexercpp.h>
 #include <QScrollBar>
+#include <QFileSystemWatcher>
 
 //include other Lepton classes and objects
 #include "scintillaeditor.h"
 #include "leptonconfig.h"
+#include "savejob.h"
+#include "textencoding.h"
+#include "linediff.h"
+
+//include other standard library classes
+#include <climits>
 
 #include <QDebug>
 
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+struct FormattingStatistics {
+    int crlf;               //number of lines ending with "\r\n"
+    int lf;                 //number of lines ending with "\n"
+    int cr;                 //number of lines ending with "\r"
+    int tabIndented;        //number of lines indented with tabs
+    int spaceIndented;      //number of lines indented with (at least two) spaces
+    int indentSteps[9];     //number of times the indentation grew by 1 to 8 spaces from one line to the next
+
+    FormattingStatistics() : crlf(0), lf(0), cr(0), tabIndented(0), spaceIndented(0) {
+        for (int i = 0; i < 9; i++) indentSteps[i] = 0;
+    }
+};
+
+static void sniffFormatting(const char* data, int length, bool atLineStart, FormattingStatistics& statistics) {
+/*
+-adds the line endings and indentation of the lines in the `length` bytes at `data` to `statistics`
+-if `atLineStart` is false, the first (partial) line is ignored
+*/
+    bool lineStart = atLineStart;
+    int previousIndent = -1;    //indentation (in spaces) of the previous non-blank line (-1 if unknown)
+
+    for (int i = 0; i < length; i++) {
+        const char c = data[i];
+
+        if (c == '\r') {
+            if (i + 1 >= length) break;     //the line ending may continue after the sample
+            if (data[i + 1] == '\n') {
+                statistics.crlf++;
+                i++;
+            }
+            else statistics.cr++;
+            lineStart = true;
+            continue;
+        }
+        if (c == '\n') {
+            statistics.lf++;
+            lineStart = true;
+            continue;
+        }
+        if (! lineStart) continue;
+        lineStart = false;
+
+        if (c == '\t') {
+            statistics.tabIndented++;
+            previousIndent = -1;
+            continue;
+        }
+
+        int indent = 0;
+        while (i + indent < length && data[i + indent] == ' ') indent++;
+        if (i + indent >= length) break;
+
+        const char next = data[i + indent];
+        if (next == '\n' || next == '\r') {   //blank lines say nothing about indentation
+            i += indent - 1;
+            continue;
+        }
+        if (next == '\t') {                    //spaces followed by tabs are counted as tabs
+            statistics.tabIndented++;
+            previousIndent = -1;
+            i += indent;
+            continue;
+        }
+
+        //a single space is more likely alignment (ex. " * " in block comments) than indentation
+        if (indent >= 2) statistics.spaceIndented++;
+        if (previousIndent >= 0 && indent > previousIndent && indent - previousIndent <= 8) statistics.indentSteps[indent - previousIndent]++;
+        previousIndent = indent;
+        i += indent;
+    }
+}
+
+static QFileSystemWatcher* sharedFileWatcher() {
+/*  -returns the watcher used by all editors to be notified when their file is changed by another program */
+    static QFileSystemWatcher* watcher = new QFileSystemWatcher();
+    return watcher;
+}
+
+static QHash<QString, int>& watcherUseCounts() {
+/*  -returns the number of editors watching each file watched by `sharedFileWatcher()` */
+    static QHash<QString, int> counts;
+    return counts;
+}
+
+
+
 //~public method implementation~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 ScintillaEditor::ScintillaEditor(QWidget* parent) : QsciScintilla(parent) {
@@ -60,6 +155,47 @@ ScintillaEditor::ScintillaEditor(QWidget* parent) : QsciScintilla(parent) {
     //create the lexer manager
     lexerManager = new SyntaxHighlightManager(this);
 
+    //files are loaded as raw bytes, so the document must be stored as UTF-8
+    setUtf8(true);
+
+    loaderThread = 0;
+    loader = 0;
+    primaryView = 0;    //the editor is the only view of its document until it is made to show another one
+    loadDeferred = false;
+    deferredLine = 0;
+    deferredIndex = 0;
+    following = false;
+    followOffset = 0;
+    followDiscarded = false;
+    bytesLoaded = 0;
+    bytesToLoad = 0;
+    decoder = 0;
+
+    //count changes to the text, to know if it changed while it was being saved
+    saveInProgress = false;
+    queuedSaveTransforms = 0;
+    changeCount = 0;
+    snapshotChangeCount = 0;
+    saveTransformsSkipped = false;
+    connect(this, SIGNAL(textChanged()), this, SLOT(countChange()));
+
+    //lines which are edited are tagged with an invisible marker (markers move with their lines as text is added or removed)
+    modifiedLineMarker = markerDefine(QsciScintilla::Invisible);
+    connect(this, SIGNAL(SCN_MODIFIED(int,int,const char*,int,int,int,int,int,int,int)), this, SLOT(markModifiedLines(int,int,const char*,int,int)));
+    reloading = false;
+
+    //files changed by other programs (ex. a build tool or a checkout) are checked once they stop changing for a moment
+    knownFileSize = -1;
+    fileCheckTimer.setSingleShot(true);
+    fileCheckTimer.setInterval(200);
+    connect(&fileCheckTimer, SIGNAL(timeout()), this, SLOT(checkOpenFile()));
+    connect(sharedFileWatcher(), SIGNAL(fileChanged(QString)), this, SLOT(watchedFileChanged(QString)));
+
+    //changes which are not saved are journaled, so that they can be recovered after a crash
+    journal = new EditJournal(this);
+    journalMark = 0;
+    connect(this, SIGNAL(SCN_MODIFIED(int,int,const char*,int,int,int,int,int,int,int)), this, SLOT(journalModification(int,int,const char*,int)));
+
     //set editor properties/settings
     setAutoIndent(true);
     setTabWidth(4);
@@ -83,37 +219,128 @@ ScintillaEditor::ScintillaEditor(QWidget* parent) : QsciScintilla(parent) {
 
 ScintillaEditor::~ScintillaEditor() {
 /* clean up and delete allocated memory */
+    //saves requested before the document was closed are still written
+    waitForSave();
+
+    //the document stays open in its other views
+    if (primaryView != 0) primaryView->secondaryViews.removeAll(this);
+    else if ( !secondaryViews.isEmpty() ) handOverDocument();
+
+    //stop loading the file, if it is still being loaded
+    stopLoader();
+    finishDecoding();
+
+    //stop watching the file
+    openFile = QFileInfo();
+    watchOpenFile();
+
     //delete allocated memory
     delete lexerManager;
 }
 
-void ScintillaEditor::writeToFile(const QString& filePath, bool changeModify) {
+bool ScintillaEditor::writeToFile(const QString& filePath, bool changeModify, int transforms) {
 /*
 -writes edited text to a file
 -parameters:
     filePath: bath to file
     changeModify: if true, call setModified() to change the modified state, otherwise do nothing
+    transforms: save transforms (see SaveTransforms) applied to the text before it is written
+-returns true if the file was written, false otherwise
 */
-    QFile file(filePath);
 
-    if ( !file.open(QIODevice::ReadWrite | QIODevice:: WriteOnly) ) {
-        QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot write to file %1:\n%2.").arg(filePath).arg(file.errorString()));
-        return;
+    //a save in progress could otherwise finish after this one, replacing the file with an older text
+    waitForSave();
+
+    //the transforms are applied to the document itself, so that it stays the same as the file
+    if (transforms != 0) applyEdits( SaveTransforms::apply(reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) ),
+                                                           length(), saveTransformOptions(transforms, true)) );
+
+    //UTF-8 text is written straight from Scintilla's buffer: `SCI_GETCHARACTERPOINTER` only closes the buffer's gap, it does not copy the document
+    const char* text = reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) );
+    qint64 textLength = length();
+
+    //text in other encodings is converted back to the encoding the file was read in
+    QByteArray encoded;
+    if (! fileFormat.isUtf8() ) {
+        encoded = encodedText();
+        text = encoded.constData();
+        textLength = encoded.size();
     }
 
-    //resize file to fit edited text
-    if ( !file.resize( this->length() ) ) {
-        QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot write to file %1:\n%2.").arg(filePath).arg(file.errorString()));
-        return;
+    QString errorString;
+    if (! SaveJob::writeFile(filePath, text, textLength, SaveJob::syncDirectoryOnSave(), &errorString) ) {
+        QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot write to file %1:\n%2.").arg(filePath).arg(errorString));
+        return false;
     }
-    file.write( this->text().toUtf8() );    //write edited text
-    file.close();
 
     if (changeModify) setModified(false);
+    if ( QFileInfo(filePath).absoluteFilePath() == openFile.absoluteFilePath() ) {
+        watchOpenFile();        //the change is not one made by another program
+        if (changeModify) rebaseJournal();
+    }
+    return true;
+}
+
+void ScintillaEditor::saveInBackground(const QString& filePath, int transforms) {
+/*
+-writes the text to a file on a background thread and marks the document as saved once it is written
+ (unless it was changed in the meantime)
+-`transforms` are the save transforms (see SaveTransforms) applied to the text before it is written
+-`saveFailed()` is emitted if the file could not be written
+*/
+
+    /*########################################################################################
+    ### Only a snapshot of the text is taken here (a single copy of the buffer); the file   ##
+    ### is written by a `SaveJob` on the save thread pool, so several files can be written  ##
+    ### at once without blocking the editor.  The save transforms and the conversion to the ##
+    ### file's encoding are done by the job too, and the edits made by the transforms are   ##
+    ### sent back to be applied to the document.  Saves of the same document are done one  ##
+    ### after the other so that an older snapshot can never replace a newer one.            ##
+    ########################################################################################*/
+
+    if (saveInProgress) {
+        queuedSavePath = filePath;
+        queuedSaveTransforms = transforms;
+        return;
+    }
+
+    QByteArray snapshot(reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) ), length());
+    SaveJob* job = new SaveJob(filePath, snapshot, fileFormat, saveTransformOptions(transforms, true));
+    connect(job, SIGNAL(transformed(SaveTransforms::EditList,bool)), this, SLOT(applySaveTransforms(SaveTransforms::EditList,bool)));
+    connect(job, SIGNAL(finished(QString,bool,QString)), this, SLOT(backgroundSaveFinished(QString,bool,QString)));
+
+    saveInProgress = true;
+    snapshotChangeCount = changeCount;
+    saveTransformsSkipped = false;
+    journalMark = journal->mark();
+    SaveJob::threadPool()->start(job);
+}
+
+bool ScintillaEditor::isSaving() {
+/*  -returns true if the document is being saved in the background */
+    return saveInProgress;
+}
+
+void ScintillaEditor::waitForSave() {
+/*  -blocks until the document is not being saved in the background anymore, including the saves queued after the current one */
+
+    //the result of a save is delivered to the document as an event, which may start the next save queued
+    while (saveInProgress) {
+        SaveJob::threadPool()->waitForDone();
+        QCoreApplication::sendPostedEvents(this);
+    }
 }
 
 void ScintillaEditor::loadFile(const QString& filePath) {
-/* -load contents of a file to be edited */
+/*
+-load contents of a file to be edited
+-large files are loaded progressively, without blocking (see `loadProgress()` and `loadFinished()`)
+*/
+    loadDeferred = false;   //a file loaded explicitly replaces the one which was deferred
+    if (following) {        //and one which was followed
+        following = false;
+        setReadOnly(false);
+    }
     QFile file(filePath);
 
     if ( !file.open(QIODevice::ReadWrite) ) {
@@ -121,8 +348,23 @@ void ScintillaEditor::loadFile(const QString& filePath) {
         return;
     }
 
-    //set the text in the editor
-    this->setText( file.readAll() );
+    //stop loading any file which is still being loaded
+    cancelLoading();
+
+    //large files are read on a worker thread and added to the editor a block at a time
+    qint64 streamingThreshold = LeptonConfig::mainSettings->getValueOrDefault(8388608, "large_files", "streaming_load_threshold").toLongLong();
+    if (streamingThreshold > 0 && file.size() > streamingThreshold) {
+        qint64 fileSize = file.size();
+        file.close();
+        startLoading(filePath, fileSize);
+        return;
+    }
+
+    //set the text in the editor (from a memory map if possible)
+    if (! loadMapped(file) ) {
+        QByteArray contents = file.readAll();
+        setDocumentBytes(reinterpret_cast<const uchar*>( contents.constData() ), contents.size());
+    }
     file.close();
 
     //save the new file path
@@ -130,29 +372,222 @@ void ScintillaEditor::loadFile(const QString& filePath) {
 
     //do not consider the file as having been modified (it was just opened)
     setModified(false);
+    clearModifiedLines();
 
     //set a lexer for the new file
     lexerManager->setLexerForFile( file.fileName() );
+
+    //use the line endings and indentation of the file, and make sure very long lines (ex. minified files) do not slow the editor down
+    detectFormatting();
+    configureForLongLines();
+
+    watchOpenFile();
+    rebaseJournal();
+    updateViews();
+}
+
+bool ScintillaEditor::isLoading() {
+/*  -returns true if a file is still being loaded into the editor */
+    return loader != 0;
+}
+
+void ScintillaEditor::deferLoading(const QString& filePath, int line, int index) {
+/*
+-makes the editor stand for a file without reading it yet (ex. a tab restored from a session)
+-the file is loaded, and the caret moved to `line` and `index`, when `loadDeferredFile()` is called
+*/
+
+    /*########################################################################################
+    ### Reading and highlighting every file of a large session before the window is shown  ##
+    ### makes startup as slow as the session is big.  A deferred editor only records the   ##
+    ### path of its file (so it is reported as open, ex. to label its tab or to save the   ##
+    ### session) and is loaded when its tab is first shown, or when there is time to spare. ##
+    ########################################################################################*/
+
+    if (loader != 0 || primaryView != 0 || !secondaryViews.isEmpty()) return;
+    openFile.setFile(filePath);
+    loadDeferred = true;
+    deferredLine = line;
+    deferredIndex = index;
+}
+
+bool ScintillaEditor::isLoadDeferred() {
+/*  -returns true if the editor stands for a file which was not loaded yet */
+    return loadDeferred;
+}
+
+bool ScintillaEditor::loadDeferredFile(const PrefetchJob::Contents* contents) {
+/*
+-loads the file set by `deferLoading()` (if any); returns false if it could not be opened
+-if `contents` is given, and was read from that file, the file is not read again
+*/
+    if (! loadDeferred) return true;
+
+    QString filePath = openFile.absoluteFilePath();
+    openFile = QFileInfo();     //the editor is left empty (and untitled) if the file can not be opened
+    if ( contents != 0 && contents->loaded && QFileInfo(contents->filePath).absoluteFilePath() == filePath ) loadPrefetched(*contents);
+    else loadFile(filePath);
+    if (! openFile.exists() ) return false;
+
+    setCursorPosition(deferredLine, deferredIndex);
+    return true;
+}
+
+void ScintillaEditor::getSessionCursorPosition(int* line, int* index) {
+/*  -gets the caret position to save in the session (the one to restore, if the file was not loaded yet) */
+    if (loadDeferred) {
+        *line = deferredLine;
+        *index = deferredIndex;
+    }
+    else getCursorPosition(line, index);
+}
+
+bool ScintillaEditor::setFollowing(bool follow) {
+/*
+-turns follow mode on or off: while it is on, text appended to the file by another program (ex. to a log)
+ is appended to the document, and views showing the end of the document scroll to show it
+-the document can not be edited while it is followed; returns false if it can not be followed (ex. it has unsaved changes)
+*/
+    if (primaryView != 0) return primaryView->setFollowing(follow);    //the document is followed by its owner
+    if (follow == following) return true;
+
+    if (follow) {
+        if ( loader != 0 || loadDeferred || watchedFilePath.isEmpty() || isModified() ) return false;
+
+        /*######################################################################################
+        ### Reopening a log to see what was added to it reads (and highlights) the whole file ##
+        ### every time.  A followed document is instead the file as it was last read, and    ##
+        ### only the bytes added after that are read when the file changes.  Text appended   ##
+        ### is not recorded for undo or journaled, so the document can not be edited.        ##
+        ######################################################################################*/
+
+        following = true;
+        followDiscarded = false;
+        followOffset = qMax(qint64(0), knownFileSize);
+        setReadOnly(true);
+        setUndoCollection(false);
+        emptyUndoBuffer();
+        startDecoding();    //a character cut at the end of what was read is completed by the next read
+        readAppendedText();
+
+        //like `tail -f`, following starts at the end of the file
+        SendScintilla(SCI_DOCUMENTEND);
+        foreach (ScintillaEditor* view, secondaryViews) view->SendScintilla(SCI_DOCUMENTEND);
+        return true;
+    }
+
+    following = false;
+    finishDecoding();
+
+    //a document whose start was discarded is only the end of its file, so the whole file is loaded again to be edited
+    if (followDiscarded) {
+        loadFile( openFile.absoluteFilePath() );
+        return true;
+    }
+
+    setReadOnly(false);
+    setUndoCollection(true);
+    emptyUndoBuffer();
+    setModified(false);
+    watchOpenFile();
+    rebaseJournal();
+    return true;
+}
+
+bool ScintillaEditor::isFollowing() {
+/*  -returns true if the document is in follow mode */
+    return documentOwner()->following;
+}
+
+double ScintillaEditor::loadFraction() {
+/*  -returns the fraction (between 0 and 1) of the file being loaded which was added to the editor */
+    if (bytesToLoad <= 0) return 1.0;
+    return double(bytesLoaded) / bytesToLoad;
 }
 
 bool ScintillaEditor::isFileOpen() {
 /*  -returns true if a file is open and being edited, false otherwise */
-    return openFile.exists();   //the only time a file is open is when it's defined (path not empty) and it exists
+    return documentOwner()->openFile.exists();  //the only time a file is open is when it's defined (path not empty) and it exists
 }
 
 QString ScintillaEditor::getOpenFilePath() {
 /* -get the path to the file currently being edited */
-    return openFile.absoluteFilePath();
+    return documentOwner()->openFile.absoluteFilePath();
 }
 
 QString ScintillaEditor::getOpenFileDir() {
 /*  -get the directory of the file currently being edited */
-    return openFile.absolutePath();
+    return documentOwner()->openFile.absolutePath();
 }
 
 QString ScintillaEditor::getOpenFileName() {
 /* -get the name of the file currently being edited */
-    return openFile.fileName();
+    return documentOwner()->openFile.fileName();
+}
+
+TextEncoding::Format ScintillaEditor::getFileFormat() {
+/*  -returns the encoding of the file being edited (it is saved in the same encoding) */
+    return documentOwner()->fileFormat;
+}
+
+void ScintillaEditor::showDocumentOf(ScintillaEditor* editor) {
+/*  -makes this editor another view of the document edited in `editor` (the caret and the scrolling of each view are their own) */
+
+    /*##########################################################################################
+    ### A Scintilla document (its text, styling, markers and undo history) can be shown in   ##
+    ### several editors at once, so a file opened in two tabs is only held in memory once    ##
+    ### and edits made in one tab are seen in the other.  Only the view which loaded the     ##
+    ### document (its owner) loads, saves, watches, styles and journals it; the other views  ##
+    ### forward to it.  If the owner is closed, another view takes over (see                 ##
+    ### `handOverDocument()`).                                                               ##
+    ##########################################################################################*/
+
+    ScintillaEditor* owner = editor->documentOwner();
+    if (owner == this || loader != 0) return;
+
+    setDocument( owner->document() );
+    primaryView = owner;
+    owner->secondaryViews.append(this);
+
+    //the document is styled by the owner's lexer, and shown with the owner's language; the line layout is a setting of each view
+    lexerManager->showStylesOf(owner->lexerManager);
+    configureForLongLines();
+}
+
+ScintillaEditor* ScintillaEditor::documentOwner() {
+/*  -returns the editor which loads, saves and journals the document shown (this editor, unless it is another view of one) */
+    return primaryView != 0 ? primaryView : this;
+}
+
+bool ScintillaEditor::hasOtherViews() {
+/*  -returns true if the document is also shown in another editor */
+    return primaryView != 0 || !secondaryViews.isEmpty();
+}
+
+QString ScintillaEditor::getLanguageName() {
+/*  -returns the name of the language used to highlight the document */
+    return documentOwner()->lexerManager->getLanguageName();
+}
+
+void ScintillaEditor::recoverChanges(const EditJournal::Recovery& recovery) {
+/*
+-applies the changes recovered from a journal to the document (which must be the journal's base), as a single undo action
+-if the file is still being loaded, the changes are applied once it is loaded
+*/
+    loadDeferredFile();
+    if (loader != 0) {
+        pendingRecoveries.append(recovery);
+        return;
+    }
+
+    beginUndoAction();
+    bool complete = EditJournal::replay(recovery.records, this);
+    endUndoAction();
+
+    if (! complete) {
+        QString name = openFile.fileName().isEmpty() ? tr("an untitled document") : openFile.fileName();
+        QMessageBox::warning(this, tr("Lepton Error"), tr("Some of the unsaved changes to %1 could not be recovered.").arg(name));
+    }
 }
 
 bool ScintillaEditor::wasFileSaved() {
@@ -161,71 +596,803 @@ bool ScintillaEditor::wasFileSaved() {
 }
 
 QMenu* ScintillaEditor::getLanguageMenu() {
-/* -returns the language selection menu */
-    return lexerManager->getLanguageMenu();
+/* -returns the language selection menu (the owner's, for another view of a document, since its lexer styles the document) */
+    return documentOwner()->lexerManager->getLanguageMenu();
 }
 
 
 
-//~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//~private method implementation~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-void ScintillaEditor::changeTabsToSpaces() {
-/*  -changes indentation tabs into spaces */
-    //go through the text line by line and replace tabs with spaces
-    QStringList editorTextLines = text().split( QRegularExpression("\n") );
+void ScintillaEditor::configureForLongLines(int longestLine) {
+/*
+-adjusts layout caching and line wrapping depending on whether the document contains very long lines
+-`longestLine` is the length of the longest line, if it is already known (-1 otherwise)
+*/
+    int threshold = LeptonConfig::mainSettings->getValueOrDefault(10000, "large_files", "long_line_threshold").toInt();
+    bool softWrap = LeptonConfig::mainSettings->getValueOrDefault(false, "large_files", "soft_wrap_long_lines").toBool();
 
-    QString replaceText("");
-    for (int i = 0, l = tabWidth(); i < l; i++) {
-        replaceText.append(' ');
+    bool hasLongLines = false;
+    if (longestLine >= 0) hasLongLines = threshold > 0 && longestLine > threshold;
+    else if (threshold > 0 && length() > threshold) {
+        for (int i = 0, c = lines(); i < c && !hasLongLines; i++) {
+            hasLongLines = lineLength(i) > threshold;
+        }
     }
 
-    for (int i = 0, l = editorTextLines.length(); i < l; i++) {
-        editorTextLines[i].replace('\t', replaceText);
+    /*#############################################################################################
+    ### Laying out a line requires measuring every one of its characters, which is very slow for ##
+    ### lines that are megabytes long.  Caching the layout of every line on the visible page     ##
+    ### prevents Scintilla from laying those lines out again each time the view is repainted.   ##
+    ### Wrapping is turned off because it forces the whole line to be laid out, unless the user ##
+    ### has asked for long lines to be visually split into segments (soft wrapping), in which    ##
+    ### case lines are wrapped on any character, which is the cheapest way to wrap them.        ##
+    #############################################################################################*/
+
+    if (hasLongLines) {
+        SendScintilla(SCI_SETLAYOUTCACHE, SC_CACHE_PAGE);
+        SendScintilla(SCI_SETPOSITIONCACHE, 4096);
+        if (softWrap) {
+            setWrapMode(WrapCharacter);
+            setWrapVisualFlags(WrapFlagByBorder);
+        }
+        else {
+            setWrapMode(WrapNone);
+        }
+    }
+    else {
+        SendScintilla(SCI_SETLAYOUTCACHE, SC_CACHE_CARET);  //Scintilla's default
+        SendScintilla(SCI_SETPOSITIONCACHE, 1024);          //Scintilla's default
+        setWrapMode(WrapNone);
     }
+}
+
+
+
+void ScintillaEditor::detectFormatting() {
+/*  -sets the line ending mode and the indentation used by the editor to the ones used in the document */
+
+    /*##########################################################################################
+    ### Only a bounded sample of the document is looked at: its first 64KiB plus 16 blocks of ##
+    ### 4KiB spread evenly over the rest of it.  This is enough to recognize the conventions  ##
+    ### of a file while costing about the same for a file of a few kilobytes as for one of    ##
+    ### several gigabytes.  The settings are only changed when the sample is conclusive, so   ##
+    ### a file which is, for example, indented with tabs is not converted by accident when    ##
+    ### it is edited.                                                                          ##
+    ##########################################################################################*/
+
+    const int documentLength = length();
+    if (documentLength == 0) return;
 
-    setText( editorTextLines.join("\n") );
+    //after loading, the gap of the buffer is at its end, so getting a pointer to the text does not move anything
+    const char* text = reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) );
+
+    FormattingStatistics statistics;
+    const int headLength = qMin(documentLength, 65536);
+    sniffFormatting(text, headLength, true, statistics);
+
+    const int sampleCount = 16;
+    const int sampleLength = 4096;
+    const int remainingLength = documentLength - headLength;
+    if (remainingLength > sampleLength) {
+        for (int i = 0; i < sampleCount; i++) {
+            int start = headLength + int( qint64(remainingLength - sampleLength) * i / (sampleCount - 1) );
+            sniffFormatting(text + start, sampleLength, false, statistics);
+        }
+    }
+
+    //use the most common line ending
+    if (statistics.crlf > 0 || statistics.lf > 0 || statistics.cr > 0) {
+        if (statistics.crlf >= statistics.lf && statistics.crlf >= statistics.cr) setEolMode(EolWindows);
+        else if (statistics.lf >= statistics.cr) setEolMode(EolUnix);
+        else setEolMode(EolMac);
+    }
+
+    //use the most common kind of indentation and, for spaces, the most common indentation step
+    if (statistics.tabIndented > statistics.spaceIndented) setIndentationsUseTabs(true);
+    else if (statistics.spaceIndented > 0) {
+        setIndentationsUseTabs(false);
+        int width = 0;
+        for (int step = 2; step <= 8; step++) {
+            if (statistics.indentSteps[step] > 0 && (width == 0 || statistics.indentSteps[step] > statistics.indentSteps[width])) width = step;
+        }
+        if (width > 0) setIndentationWidth(width);
+    }
 }
 
-void ScintillaEditor::changeSpacesToTabs() {
-/*  -changes spaces into tabs */
-    //go through the text line by line and replace spaces with tabs
-    QStringList editorTextLines = text().split( QRegularExpression("\n") );
+void ScintillaEditor::convertIndentation(bool useTabs) {
+/*
+-rewrites the indentation at the start of every line using tabs (followed by spaces up to the indentation
+ column) if `useTabs` is true, or using only spaces otherwise
+*/
+
+    /*########################################################################################
+    ### Scintilla already knows the column each line's indentation reaches (with tabs      ##
+    ### expanded to the next tab stop), so only the whitespace before it is rewritten, and  ##
+    ### only on lines where it actually differs.  All the changes are made as a single undo ##
+    ### action, and since the rest of the text is not replaced, styling only needs to be   ##
+    ### redone from the first line that changed.                                            ##
+    ########################################################################################*/
 
-    QString textExpression = tr("\\s{2,%1}").arg( tabWidth() );
+    const int width = tabWidth();
 
-    for (int i = 0, l = editorTextLines.length(); i < l; i++) {
-        editorTextLines[i].replace( QRegularExpression(textExpression), "\t");
+    beginUndoAction();
+    for (int line = 0, count = lines(); line < count; line++) {
+        const int lineStart = SendScintilla(SCI_POSITIONFROMLINE, line);
+        const int indentEnd = SendScintilla(SCI_GETLINEINDENTPOSITION, line);
+        if (indentEnd == lineStart) continue;
+
+        const int columns = SendScintilla(SCI_GETLINEINDENTATION, line);
+        QByteArray indentation = useTabs ? QByteArray(columns / width, '\t') + QByteArray(columns % width, ' ') : QByteArray(columns, ' ');
+
+        //lines which are already indented the right way are left alone
+        bool same = indentEnd - lineStart == indentation.size();
+        for (int i = 0; same && i < indentation.size(); i++) {
+            same = char( SendScintilla(SCI_GETCHARAT, lineStart + i) ) == indentation.at(i);
+        }
+        if (same) continue;
+
+        SendScintilla(SCI_SETTARGETSTART, lineStart);
+        SendScintilla(SCI_SETTARGETEND, indentEnd);
+        SendScintilla(SCI_REPLACETARGET, indentation.size(), indentation.constData());
+    }
+    endUndoAction();
+}
+
+bool ScintillaEditor::loadMapped(QFile& file) {
+/*
+-sets the text in the editor to the contents of `file`, read from a memory map
+-returns false, leaving the editor unchanged, if the file can not be mapped into memory
+*/
+    const qint64 size = file.size();
+    if (size == 0) {
+        clear();
+        fileFormat = TextEncoding::Format();
+        return true;
     }
+    if (size >= INT_MAX) return false;  //Scintilla positions are ints
+
+    uchar* data = file.map(0, size);
+    if (data == 0) return false;
+
+    setDocumentBytes(data, size);
 
-    setText( editorTextLines.join("\n") );
+    file.unmap(data);
+    return true;
 }
 
+void ScintillaEditor::setDocumentBytes(const uchar* data, qint64 size) {
+/*  -sets the text in the editor to the `size` bytes of a file at `data`, converting them to UTF-8 if they are encoded otherwise */
+
+    /*###########################################################################################
+    ### Reading a file into a QByteArray, converting it to a QString (UTF-16) and handing it   ##
+    ### to `setText()` (which converts it back to UTF-8) holds the file in memory several      ##
+    ### times and spends most of the time converting it.  Since the document is stored as     ##
+    ### UTF-8, a file that is valid UTF-8 can be copied straight into a document allocated to  ##
+    ### the right size, which is about as fast as reading the file.  Files in other encodings ##
+    ### are converted a block at a time.  Undo collection is turned off while the text is      ##
+    ### inserted so that Scintilla does not keep a second copy of it.                          ##
+    ###########################################################################################*/
+
+    fileFormat = TextEncoding::detect(data, size);
+    const int bomLength = fileFormat.hasBom ? TextEncoding::byteOrderMark(fileFormat.encoding).size() : 0;
+
+    setUndoCollection(false);
+    SendScintilla(SCI_CLEARALL);
+    if (fileFormat.encoding == TextEncoding::Utf8) SendScintilla(SCI_ALLOCATE, size + 1);
+
+    startDecoding();
+    appendEncoded(reinterpret_cast<const char*>(data) + bomLength, size - bomLength);
+    finishDecoding();
+
+    setUndoCollection(true);
+    emptyUndoBuffer();
+}
+
+void ScintillaEditor::startDecoding() {
+/*  -prepares to add text encoded in `fileFormat` to the document */
+    finishDecoding();
+    if (fileFormat.encoding != TextEncoding::Utf8) decoder = TextEncoding::codecFor(fileFormat.encoding)->makeDecoder(QTextCodec::IgnoreHeader);
+}
+
+void ScintillaEditor::appendEncoded(const char* data, qint64 size) {
+/*  -adds `size` bytes of text, encoded in `fileFormat`, to the end of the document (`startDecoding()` must be called first) */
+    if (decoder == 0) {
+        SendScintilla(SCI_APPENDTEXT, size, data);
+        return;
+    }
+
+    //the text is converted in blocks so that the whole file is never held as UTF-16 at once
+    const qint64 blockSize = 1048576;
+    for (qint64 i = 0; i < size; i += blockSize) {
+        QByteArray block = decoder->toUnicode(data + i, int( qMin(blockSize, size - i) )).toUtf8();
+        SendScintilla(SCI_APPENDTEXT, block.size(), block.constData());
+    }
+}
+
+void ScintillaEditor::finishDecoding() {
+/*  -deletes the decoder used to convert text added to the document */
+    delete decoder;
+    decoder = 0;
+}
+
+QByteArray ScintillaEditor::encodedText() {
 /*
-remove the spaces at the end of each line
+-returns the text converted to the encoding of the file (including its byte order mark)
+-if some characters can not be represented in that encoding, the file is switched to UTF-8 instead of losing them
+*/
+    const char* text = reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) );
+
+    bool lossless = true;
+    QByteArray encoded = TextEncoding::fromUtf8(text, length(), fileFormat, &lossless);
+    if (! lossless) {
+        fileFormat = TextEncoding::Format();
+        encoded = QByteArray(text, length());
+    }
+    return encoded;
+}
+
+void ScintillaEditor::loadPrefetched(const PrefetchJob::Contents& contents) {
+/*  -sets the text in the editor to the contents of a file read in the background, and makes it the file being edited */
+    loadDeferred = false;
+    cancelLoading();
+
+    //the text was already converted to UTF-8, so it is copied straight into a document allocated to the right size
+    fileFormat = contents.format;
+    setUndoCollection(false);
+    SendScintilla(SCI_CLEARALL);
+    SendScintilla(SCI_ALLOCATE, contents.text.size() + 1);
+    SendScintilla(SCI_APPENDTEXT, contents.text.size(), contents.text.constData());
+    setUndoCollection(true);
+    emptyUndoBuffer();
+
+    openFile.setFile(contents.filePath);
+    setModified(false);
+    clearModifiedLines();
+    lexerManager->setLexerForFile( openFile.fileName() );
+    detectFormatting();
+    configureForLongLines(contents.longestLine);
+
+    //if the file changed after it was read, the text is its older version, which is journaled as such and reloaded right away
+    watchOpenFile();
+    if (knownFileSize != contents.size || knownFileModified != contents.lastModified) {
+        knownFileSize = contents.size;
+        knownFileModified = contents.lastModified;
+        fileCheckTimer.start();
+    }
+    rebaseJournal();
+    updateViews();
+}
+
+void ScintillaEditor::startLoading(const QString& filePath, qint64 fileSize) {
+/*  -starts loading a file progressively, from a worker thread */
+
+    /*##############################################################################################
+    ### Reading a file of several gigabytes with `readAll()` and giving it to `setText()` freezes  ##
+    ### the editor and holds the file in memory three times (as bytes, as a QString and in the    ##
+    ### document).  Instead, a worker thread reads the file in blocks which are appended, as      ##
+    ### bytes, to the document from the event loop.  The first screenful is visible as soon as    ##
+    ### the first block is appended and the editor stays responsive while the rest is loaded.     ##
+    ### The loader only reads a few blocks ahead of the editor, so memory stays bounded.          ##
+    ##############################################################################################*/
+
+    clear();
+    lexerManager->setLexerForFile( QString() );     //the file is shown as plain text until it is loaded
+    openFile.setFile(filePath);
+    bytesLoaded = 0;
+    bytesToLoad = fileSize;
+
+    //the document can not be edited, and appending blocks is not recorded for undo, until it is loaded
+    setReadOnly(true);
+    setUndoCollection(false);
+
+    loaderThread = new QThread(this);
+    loader = new FileLoader(filePath, 1048576);
+    loader->moveToThread(loaderThread);
+
+    connect(loaderThread, SIGNAL(started()), loader, SLOT(load()));
+    connect(loader, SIGNAL(blockRead(QByteArray)), this, SLOT(appendBlock(QByteArray)));
+    connect(loader, SIGNAL(finished()), this, SLOT(loadingDone()));
+    connect(loader, SIGNAL(failed(QString)), this, SLOT(loadingFailed(QString)));
+
+    loaderThread->start();
+    emit loadProgress(bytesLoaded, bytesToLoad);
+}
+
+void ScintillaEditor::stopLoader() {
+/*  -stops the thread reading the file being loaded and deletes the loader */
+    if (loader == 0) return;
+
+    disconnect(loader, 0, this, 0);     //blocks which were already read are not wanted anymore
+    loader->cancel();
+    loaderThread->quit();
+    loaderThread->wait();
+
+    delete loader;
+    delete loaderThread;
+    loader = 0;
+    loaderThread = 0;
+}
+
+void ScintillaEditor::clearModifiedLines() {
+/*  -forgets which lines were modified (ex. once a file was loaded) */
+    if (modifiedLineMarker >= 0) markerDeleteAll(modifiedLineMarker);
+}
+
+SaveTransforms::Options ScintillaEditor::saveTransformOptions(int transforms, bool onlyModifiedLines) {
+/*
+-returns the options to apply `transforms` to the document with the line ending and indentation set in the editor
+-if `onlyModifiedLines` is true, lines which were not changed since the file was loaded are not stripped or re-indented
+*/
+    SaveTransforms::Options options;
+    options.transforms = transforms;
+    options.eol = eolMode() == EolWindows ? "\r\n" : (eolMode() == EolMac ? "\r" : "\n");
+    options.indentUseTabs = indentationsUseTabs();
+    options.tabWidth = tabWidth();
+
+    if (onlyModifiedLines && modifiedLineMarker >= 0) {
+        options.onlyModifiedLines = true;
+        const int mask = 1 << modifiedLineMarker;
+        for (int line = SendScintilla(SCI_MARKERNEXT, 0, mask); line >= 0; line = SendScintilla(SCI_MARKERNEXT, line + 1, mask))
+            options.modifiedLines.append(line);
+    }
+    return options;
+}
+
+void ScintillaEditor::watchOpenFile() {
+/*
+-watches the file being edited (if any) for changes made by other programs, and stops watching the one watched before
+-the current state of the file is recorded as the one known to the editor
+*/
+    QFileSystemWatcher* watcher = sharedFileWatcher();
+    QHash<QString, int>& useCounts = watcherUseCounts();
+    const QString filePath = openFile.filePath().isEmpty() ? QString() : openFile.absoluteFilePath();
+
+    if (watchedFilePath != filePath) {
+        if ( !watchedFilePath.isEmpty() && --useCounts[watchedFilePath] <= 0 ) {
+            useCounts.remove(watchedFilePath);
+            watcher->removePath(watchedFilePath);
+        }
+        watchedFilePath = filePath;
+        if ( !watchedFilePath.isEmpty() ) useCounts[watchedFilePath]++;
+    }
+    if ( watchedFilePath.isEmpty() ) return;
+
+    //a file replaced by another one (ex. saved atomically) is not watched anymore, so it is watched again
+    QFileInfo info(watchedFilePath);
+    if ( info.exists() && !watcher->files().contains(watchedFilePath) ) watcher->addPath(watchedFilePath);
+    knownFileModified = info.lastModified();
+    knownFileSize = info.exists() ? info.size() : -1;
+}
+
+void ScintillaEditor::rebaseJournal() {
+/*  -discards the changes journaled so far, since the document is now the same as its file (or empty, if it has none) */
+    journal->setBase(watchedFilePath, knownFileModified, knownFileSize);
+}
+
+void ScintillaEditor::updateViews() {
+/*  -sets the line layout of the other views of the document to match the file loaded (their language follows this editor's) */
+    foreach (ScintillaEditor* view, secondaryViews) view->configureForLongLines();
+}
+
+void ScintillaEditor::handOverDocument() {
+/*  -makes another view of the document its owner, since this editor is being closed */
+    if (loader != 0) cancelLoading();   //a partly loaded document can not be saved, so it is not kept
+
+    ScintillaEditor* heir = secondaryViews.takeFirst();
+    heir->primaryView = 0;
+    heir->secondaryViews = secondaryViews;
+    foreach (ScintillaEditor* view, secondaryViews) view->primaryView = heir;
+    secondaryViews.clear();
+
+    //the heir's lexer styles the document from now on
+    heir->lexerManager->showStylesOf(0);
+    foreach (ScintillaEditor* view, heir->secondaryViews) view->lexerManager->showStylesOf(heir->lexerManager);
+
+    heir->openFile = openFile;
+    heir->fileFormat = fileFormat;
+    heir->watchOpenFile();
+
+    heir->following = following;
+    heir->followOffset = followOffset;
+    heir->followDiscarded = followDiscarded;
+    if (following) heir->startDecoding();
+
+    //the journal of the document goes with it, so the changes made since it was last saved can still be recovered
+    delete heir->journal;
+    heir->journal = journal;
+    heir->journalMark = journalMark;
+    journal->setParent(heir);
+    journal = 0;
+}
+
+bool ScintillaEditor::reloadFromDisk() {
+/*
+-updates the document to the contents of its file, replacing only the lines which changed (as a single undo action)
+-returns false if the file could not be read
 */
-void ScintillaEditor::removeTrailingSpaces() {
 
     /*######################################################################################
-    ### To remove the trailing white spaces, the program traverses the text in reverse.   ##
-    ### This is done to avoid continually changing the search position when removing      ##
-    ### spaces.  First, the algorithm searchs for a new line character or the end of      ##
-    ### the file.  Once found, it records its position and continues searching in reverse ##
-    ### for white space characters (space or tab).  When the last white space character   ##
-    ### is found, it removes them from the line in the text.  This process is repeated    ##
-    ### for every line in the file.                                                       ##
+    ### Setting the whole text again would lose the undo history, the position of the     ##
+    ### caret and of the view, and the styling of the whole document.  Instead, the lines  ##
+    ### of the document are compared to the lines of the file and only those which differ ##
+    ### are replaced, so Scintilla keeps everything else (including the lexer's state     ##
+    ### before the first change) as it was.                                                ##
     ######################################################################################*/
 
-    QString t = text();
-    for (int i = t.length(); i > 0; i--) {
-        while (i > 0 && i < t.length() && t.at(i) != '\n') // could also be an `if (...) continue` but this is clearer
-            i--;
-        int prev = i;
-        while (i > 0 && (t.at(i - 1) == ' ' || t.at(i - 1) == '\t'))
-            i--;
-        if (i < prev) {
-            SendScintilla(SCI_SETTARGETSTART, 0 > i ? 0 : i);
-            SendScintilla(SCI_SETTARGETEND, prev);
-            SendScintilla(SCI_REPLACETARGET, "");
+    QFile file( openFile.absoluteFilePath() );
+    if (! file.open(QIODevice::ReadOnly) ) return false;
+    const QByteArray contents = file.readAll();
+    file.close();
+
+    //the file is converted to UTF-8, like the document
+    const uchar* data = reinterpret_cast<const uchar*>( contents.constData() );
+    fileFormat = TextEncoding::detect(data, contents.size());
+    const int bomLength = fileFormat.hasBom ? TextEncoding::byteOrderMark(fileFormat.encoding).size() : 0;
+    QByteArray converted;
+    const char* newText = contents.constData() + bomLength;
+    int newLength = contents.size() - bomLength;
+    if (fileFormat.encoding != TextEncoding::Utf8) {
+        QTextDecoder* fileDecoder = TextEncoding::codecFor(fileFormat.encoding)->makeDecoder(QTextCodec::IgnoreHeader);
+        converted = fileDecoder->toUnicode(newText, newLength).toUtf8();
+        delete fileDecoder;
+        newText = converted.constData();
+        newLength = converted.size();
+    }
+
+    const char* oldText = reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) );
+    const QVector<LineDiff::Hunk> hunks = LineDiff::diff(oldText, length(), newText, newLength);
+
+    //the hunks are applied from the last to the first so that the positions of the others stay valid
+    const int firstLine = firstVisibleLine();
+    int firstLineShift = 0;
+    reloading = true;
+    beginUndoAction();
+    for (int i = hunks.size() - 1; i >= 0; i--) {
+        const LineDiff::Hunk& hunk = hunks.at(i);
+        SendScintilla(SCI_SETTARGETSTART, hunk.oldPosition);
+        SendScintilla(SCI_SETTARGETEND, hunk.oldPosition + hunk.oldLength);
+        SendScintilla(SCI_REPLACETARGET, hunk.newLength, newText + hunk.newPosition);
+        if (hunk.oldLine + hunk.oldCount <= firstLine) firstLineShift += hunk.newCount - hunk.oldCount;
+    }
+    endUndoAction();
+    reloading = false;
+
+    //the view follows the lines it was showing
+    if (firstLineShift != 0) setFirstVisibleLine(firstLine + firstLineShift);
+
+    setModified(false);
+    return true;
+}
+
+void ScintillaEditor::applyEdits(const SaveTransforms::EditList& edits) {
+/*  -applies `edits` (in increasing order of position) to the document, as a single undo action */
+    if ( edits.isEmpty() ) return;
+
+    //the edits are applied from the last to the first so that the positions of the others stay valid
+    beginUndoAction();
+    for (int i = edits.size() - 1; i >= 0; i--) {
+        const SaveTransforms::Edit& edit = edits.at(i);
+        SendScintilla(SCI_SETTARGETSTART, edit.position);
+        SendScintilla(SCI_SETTARGETEND, edit.position + edit.length);
+        SendScintilla(SCI_REPLACETARGET, edit.text.size(), edit.text.constData());
+    }
+    endUndoAction();
+}
+
+void ScintillaEditor::readAppendedText() {
+/*  -appends the text added to the followed file since it was last read to the document, discarding old text past the memory cap */
+
+    /*######################################################################################
+    ### The new text is appended to the end of the document, where Scintilla only styles ##
+    ### the lines it was added to: the styling of the rest of the document stays valid.  ##
+    ### So that a log followed for hours does not use ever more memory, the oldest lines ##
+    ### are discarded once the document is larger than the cap.  A quarter of the cap is ##
+    ### discarded at once, so that this is rare.                                           ##
+    ######################################################################################*/
+
+    const qint64 maxSize = qMax(qint64(1048576), LeptonConfig::mainSettings->getValueOrDefault(67108864, "follow", "max_document_size").toLongLong());
+
+    QFile file(watchedFilePath);
+    if ( !file.open(QIODevice::ReadOnly) ) {
+        watchOpenFile();
+        return;
+    }
+    const qint64 fileSize = file.size();
+
+    bool restart = false;
+    if (fileSize < followOffset) {
+        //a file which got shorter was truncated or replaced (ex. a rotated log), so it is followed from its start again
+        restart = true;
+        followDiscarded = false;
+        followOffset = fileFormat.hasBom ? qMin(fileSize, qint64( TextEncoding::byteOrderMark(fileFormat.encoding).size() )) : 0;
+    }
+    if (fileSize - followOffset > maxSize) {
+        //more text than is kept was added at once, so only its end is read
+        restart = true;
+        followDiscarded = true;
+        followOffset = fileSize - maxSize;
+    }
+    if (followOffset == fileSize && !restart) {
+        watchOpenFile();
+        return;
+    }
+
+    //views whose caret is at the end of the document keep showing its end
+    QList<ScintillaEditor*> viewsAtEnd;
+    if (SendScintilla(SCI_GETCURRENTPOS) == length()) viewsAtEnd.append(this);
+    foreach (ScintillaEditor* view, secondaryViews) {
+        if (view->SendScintilla(SCI_GETCURRENTPOS) == view->length()) viewsAtEnd.append(view);
+    }
+
+    setReadOnly(false);
+    if (restart) {
+        SendScintilla(SCI_CLEARALL);
+        startDecoding();
+    }
+
+    const qint64 blockSize = 1048576;
+    file.seek(followOffset);
+    while (followOffset < fileSize) {
+        QByteArray block = file.read( qMin(blockSize, fileSize - followOffset) );
+        if ( block.isEmpty() ) break;
+        appendEncoded(block.constData(), block.size());
+        followOffset += block.size();
+    }
+    file.close();
+
+    if (length() > maxSize) discardHead(maxSize * 3 / 4);
+    setReadOnly(true);
+
+    foreach (ScintillaEditor* view, viewsAtEnd) view->SendScintilla(SCI_DOCUMENTEND);
+    watchOpenFile();
+}
+
+void ScintillaEditor::discardHead(qint64 keepLength) {
+/*  -removes whole lines from the start of the document so that (about) its last `keepLength` bytes are left */
+    //a line longer than what is kept (which is rare in a log) is cut instead
+    const int cutLine = SendScintilla(SCI_LINEFROMPOSITION, length() - keepLength);
+    const bool wholeLines = cutLine + 1 < lines();
+    const int end = wholeLines ? int( SendScintilla(SCI_POSITIONFROMLINE, cutLine + 1) ) : int(length() - keepLength);
+    const int linesRemoved = wholeLines ? cutLine + 1 : cutLine;
+    if (end <= 0) return;
+
+    QList<ScintillaEditor*> views = secondaryViews;
+    views.prepend(this);
+    QList<int> firstLines;
+    foreach (ScintillaEditor* view, views) firstLines.append( view->firstVisibleLine() );
+
+    //the styling of the text left is still valid, so Scintilla is told not to restyle it
+    const int endStyled = SendScintilla(SCI_GETENDSTYLED);
+    SendScintilla(SCI_DELETERANGE, 0, end);
+    SendScintilla(SCI_STARTSTYLING, qMax(0, endStyled - end), 0);
+
+    for (int i = 0; i < views.size(); i++) {
+        views.at(i)->lexerManager->textRemovedFromStart(end);
+        views.at(i)->setFirstVisibleLine( qMax(0, firstLines.at(i) - linesRemoved) );
+    }
+    followDiscarded = true;
+}
+
+
+
+//~public slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void ScintillaEditor::changeTabsToSpaces() {
+/*  -changes indentation tabs into spaces */
+    convertIndentation(false);
+}
+
+void ScintillaEditor::changeSpacesToTabs() {
+/*  -changes spaces into tabs */
+    convertIndentation(true);
+}
+
+void ScintillaEditor::removeTrailingSpaces() {
+/*  -remove the spaces at the end of each line */
+    const char* text = reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) );
+    applyEdits( SaveTransforms::apply(text, length(), saveTransformOptions(SaveTransforms::StripTrailingSpaces, false)) );
+}
+
+void ScintillaEditor::cancelLoading() {
+/*  -stops loading the file being loaded, leaving the editor empty */
+    if (loader == 0) return;
+
+    stopLoader();
+    finishDecoding();
+
+    //a partly loaded file must not be saved over the complete file, so it is closed
+    setReadOnly(false);
+    clear();
+    openFile = QFileInfo();
+    watchOpenFile();
+    rebaseJournal();
+    pendingRecoveries.clear();
+    fileFormat = TextEncoding::Format();
+    setUndoCollection(true);
+    emptyUndoBuffer();
+    setModified(false);
+    clearModifiedLines();
+
+    emit loadFinished();
+}
+
+
+
+//~private slots~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void ScintillaEditor::appendBlock(const QByteArray& block) {
+/*  -adds a block of the file being loaded to the end of the document */
+    if (loader == 0 || sender() != loader) return;     //the block may have been read before loading was canceled
+
+    //the encoding of the file is detected from its first block
+    int skippedLength = 0;
+    if (bytesLoaded == 0) {
+        fileFormat = TextEncoding::detect(reinterpret_cast<const uchar*>( block.constData() ), block.size(), bytesToLoad <= block.size());
+        if (fileFormat.hasBom) skippedLength = TextEncoding::byteOrderMark(fileFormat.encoding).size();
+        startDecoding();
+    }
+
+    //UTF-8 blocks are appended as bytes (a character split between two blocks is joined again in the document),
+    //  blocks in other encodings are converted (the decoder keeps the part of a character cut at the end of a block)
+    setReadOnly(false);
+    appendEncoded(block.constData() + skippedLength, block.size() - skippedLength);
+    setReadOnly(true);
+    loader->blockConsumed();
+
+    bytesLoaded += block.size();
+    emit loadProgress(bytesLoaded, bytesToLoad);
+}
+
+void ScintillaEditor::loadingDone() {
+/*  -called when the whole file being loaded was read, to make the document editable */
+    if (loader == 0 || sender() != loader) return;
+    stopLoader();
+    finishDecoding();
+
+    setReadOnly(false);
+    setUndoCollection(true);
+    emptyUndoBuffer();
+    setModified(false);
+    clearModifiedLines();
+
+    //the lexer is only set once the file is loaded, so that it does not restart every time a block is appended
+    lexerManager->setLexerForFile( openFile.fileName() );
+    detectFormatting();
+    configureForLongLines();
+    watchOpenFile();
+    rebaseJournal();
+    updateViews();
+
+    //changes recovered while the file was being loaded can only be applied now
+    QList<EditJournal::Recovery> recoveries = pendingRecoveries;
+    pendingRecoveries.clear();
+    foreach (const EditJournal::Recovery& recovery, recoveries) recoverChanges(recovery);
+
+    emit loadFinished();
+}
+
+void ScintillaEditor::loadingFailed(const QString& errorString) {
+/*  -called if the file being loaded could not be read */
+    if (loader == 0 || sender() != loader) return;
+    QString filePath = openFile.absoluteFilePath();
+    cancelLoading();
+    QMessageBox::warning(this, tr("Lepton Error"), tr("Cannot open file %1:\n%2.").arg(filePath).arg(errorString));
+}
+
+void ScintillaEditor::countChange() {
+/*  -records that the text changed */
+    changeCount++;
+}
+
+void ScintillaEditor::markModifiedLines(int position, int modificationType, const char* text, int length, int linesAdded) {
+/*  -tags the lines changed by a modification of the document (text added while loading a file is not recorded for undo, and not tagged) */
+    Q_UNUSED(text);
+    Q_UNUSED(length);
+    if ( modifiedLineMarker < 0 || (modificationType & (SC_MOD_INSERTTEXT | SC_MOD_DELETETEXT)) == 0 ) return;
+    if ( SendScintilla(SCI_GETUNDOCOLLECTION) == 0 || reloading ) return;     //lines reloaded from the file are not modified either
+    if (primaryView != 0) return;   //the document is shared, and its owner tags the lines
+
+    const int mask = 1 << modifiedLineMarker;
+    const int firstLine = SendScintilla(SCI_LINEFROMPOSITION, position);
+    const int lastLine = firstLine + qMax(linesAdded, 0);   //removing text joins lines into the first one
+    for (int line = firstLine; line <= lastLine; line++) {
+        if ( (SendScintilla(SCI_MARKERGET, line) & mask) == 0 ) SendScintilla(SCI_MARKERADD, line, modifiedLineMarker);
+    }
+}
+
+void ScintillaEditor::journalModification(int position, int modificationType, const char* text, int length) {
+/*  -adds a modification of the document to the journal (text added while loading or reloading a file is not journaled) */
+    if ( SendScintilla(SCI_GETUNDOCOLLECTION) == 0 || reloading || primaryView != 0 ) return;     //only the owner of the document journals it
+    if (modificationType & SC_MOD_INSERTTEXT) journal->recordInsert(position, text, length);
+    else if (modificationType & SC_MOD_DELETETEXT) journal->recordDelete(position, length);
+}
+
+void ScintillaEditor::watchedFileChanged(const QString& filePath) {
+/*  -called when a watched file was changed, replaced or removed by another program */
+    if (filePath != watchedFilePath) return;
+
+    //a followed file (ex. a log) may never stop changing, so it is checked at most once per interval instead
+    if ( following && fileCheckTimer.isActive() ) return;
+    fileCheckTimer.start();     //the file is only checked once it stopped changing for a moment
+}
+
+void ScintillaEditor::checkOpenFile() {
+/*  -reloads the file being edited if it was changed by another program (asking first if the document has unsaved changes) */
+    if ( watchedFilePath.isEmpty() || loader != 0 ) return;
+    if (saveInProgress) return;     //the file is watched again, and its state recorded, once it is saved
+
+    QFileInfo info(watchedFilePath);
+    if (! info.exists() ) return;   //the file was removed; the document is kept so that it can be saved again
+    if (following) {
+        readAppendedText();
+        return;
+    }
+    if ( info.size() == knownFileSize && info.lastModified() == knownFileModified ) {
+        watchOpenFile();            //the file may have been replaced by an identical one, which must be watched again
+        return;
+    }
+
+    if ( isModified() ) {
+        QMessageBox::StandardButton answer = QMessageBox::question(this, tr("Lepton"),
+                tr("%1 was changed by another program.\nReload it and discard the unsaved changes?").arg(openFile.fileName()),
+                QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if (answer != QMessageBox::Yes) {
+            watchOpenFile();        //the user is not asked again until the file changes again
+            return;
         }
     }
+
+    if ( reloadFromDisk() ) {
+        watchOpenFile();
+        rebaseJournal();
+    }
+    else watchOpenFile();
+}
+
+void ScintillaEditor::applySaveTransforms(const SaveTransforms::EditList& edits, bool savedAsUtf8) {
+/*  -applies the edits made by the save transforms to the document, so that it is the same as the file written */
+    if (savedAsUtf8) fileFormat = TextEncoding::Format();
+
+    //if the text changed since the snapshot was taken, the edits do not fit it anymore (and it stays modified anyway)
+    if (changeCount != snapshotChangeCount) {
+        saveTransformsSkipped = ! edits.isEmpty();
+        return;
+    }
+    applyEdits(edits);
+    snapshotChangeCount = changeCount;
+
+    //the edits are journaled, but the file written already has them: they are discarded with the changes made before the save
+    journalMark = journal->mark();
+}
+
+void ScintillaEditor::backgroundSaveFinished(const QString& filePath, bool succeeded, const QString& errorString) {
+/*  -called when a file saved in the background was written (or could not be) */
+    saveInProgress = false;
+
+    //the document is only marked as saved if it is still the same as the snapshot which was written
+    if (succeeded && changeCount == snapshotChangeCount) setModified(false);
+    else if (! succeeded) emit saveFailed(filePath, errorString);
+
+    //the file written is not a change made by another program, and changes made to the snapshot written need not be journaled anymore
+    if ( succeeded && QFileInfo(filePath).absoluteFilePath() == openFile.absoluteFilePath() ) {
+        watchOpenFile();
+
+        /*#####################################################################################
+        ### The changes journaled after the snapshot was taken apply to that snapshot.  If   ##
+        ### the save transforms changed it but could not be applied to the document (which   ##
+        ### was edited while it was saved), the file written is not the snapshot, so the     ##
+        ### changes can not be replayed on it: the whole text is journaled instead.          ##
+        #####################################################################################*/
+
+        if (saveTransformsSkipped) journal->checkpoint( watchedFilePath, knownFileModified, knownFileSize,
+                                                        reinterpret_cast<const char*>( SendScintillaPtrResult(SCI_GETCHARACTERPOINTER) ), length() );
+        else journal->discardUpTo(journalMark, watchedFilePath, knownFileModified, knownFileSize);
+    }
+
+    if ( ! queuedSavePath.isEmpty() ) {
+        QString nextSavePath = queuedSavePath;
+        queuedSavePath.clear();
+        saveInBackground(nextSavePath, queuedSaveTransforms);
+    }
 }
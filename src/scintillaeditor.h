@@ -43,6 +43,11 @@ Usage Agreement:
 #include <QActionGroup>
 #include <QFileInfo>
 #include <QSettings>
+#include <QThread>
+#include <QFile>
+#include <QTextDecoder>
+#include <QTimer>
+#include <QDateTime>
 
 //include QScintilla classes
 #include <Qsci/qsciscintilla.h>
@@ -52,6 +57,11 @@ Usage Agreement:
 //include Lepton files which are needed by this class
 #include "leptonlexer.h"
 #include "syntaxhighlightmanager.h"
+#include "fileloader.h"
+#include "textencoding.h"
+#include "savetransforms.h"
+#include "editjournal.h"
+#include "prefetchjob.h"
 
 class ScintillaEditor : public QsciScintilla
 {
@@ -64,16 +74,69 @@ class ScintillaEditor : public QsciScintilla
         ~ScintillaEditor();
         /* clean up and delete allocated memory */
 
-        void writeToFile(const QString& filePath, bool changeModify = false);
+        bool writeToFile(const QString& filePath, bool changeModify = false, int transforms = 0);
         /*
         -writes edited text to a file
         -parameters:
             filePath: bath to file
             changeModify: if true, call setModified() to change the modified state, otherwise do nothing
+            transforms: save transforms (see SaveTransforms) applied to the text before it is written
+        -returns true if the file was written, false otherwise
         */
 
+        void saveInBackground(const QString& filePath, int transforms = 0);
+        /*
+        -writes the text to a file on a background thread and marks the document as saved once it is written
+         (unless it was changed in the meantime)
+        -`transforms` are the save transforms (see SaveTransforms) applied to the text before it is written
+        -`saveFailed()` is emitted if the file could not be written
+        */
+
+        bool isSaving();
+        /*  -returns true if the document is being saved in the background */
+
+        void waitForSave();
+        /*  -blocks until the document is not being saved in the background anymore, including the saves queued after the current one */
+
         void loadFile(const QString& filePath);
-        /* -load contents of a file to be edited */
+        /*
+        -load contents of a file to be edited
+        -large files are loaded progressively, without blocking (see `loadProgress()` and `loadFinished()`)
+        */
+
+        bool isLoading();
+        /*  -returns true if a file is still being loaded into the editor */
+
+        void deferLoading(const QString& filePath, int line = 0, int index = 0);
+        /*
+        -makes the editor stand for a file without reading it yet (ex. a tab restored from a session)
+        -the file is loaded, and the caret moved to `line` and `index`, when `loadDeferredFile()` is called
+        */
+
+        bool isLoadDeferred();
+        /*  -returns true if the editor stands for a file which was not loaded yet */
+
+        bool loadDeferredFile(const PrefetchJob::Contents* contents = 0);
+        /*
+        -loads the file set by `deferLoading()` (if any); returns false if it could not be opened
+        -if `contents` is given, and was read from that file, the file is not read again
+        */
+
+        void getSessionCursorPosition(int* line, int* index);
+        /*  -gets the caret position to save in the session (the one to restore, if the file was not loaded yet) */
+
+        bool setFollowing(bool follow);
+        /*
+        -turns follow mode on or off: while it is on, text appended to the file by another program (ex. to a log)
+         is appended to the document, and views showing the end of the document scroll to show it
+        -the document can not be edited while it is followed; returns false if it can not be followed (ex. it has unsaved changes)
+        */
+
+        bool isFollowing();
+        /*  -returns true if the document is in follow mode */
+
+        double loadFraction();
+        /*  -returns the fraction (between 0 and 1) of the file being loaded which was added to the editor */
 
         bool isFileOpen();
         /*  -returns true if a file is open and being edited, false otherwise */
@@ -87,11 +150,32 @@ class ScintillaEditor : public QsciScintilla
         QString getOpenFileName();
         /* -get the name of the file currently being edited */
 
+        TextEncoding::Format getFileFormat();
+        /*  -returns the encoding of the file being edited (it is saved in the same encoding) */
+
+        QString getLanguageName();
+        /*  -returns the name of the language used to highlight the document */
+
+        void showDocumentOf(ScintillaEditor* editor);
+        /*  -makes this editor another view of the document edited in `editor` (the caret and the scrolling of each view are their own) */
+
+        ScintillaEditor* documentOwner();
+        /*  -returns the editor which loads, saves and journals the document shown (this editor, unless it is another view of one) */
+
+        bool hasOtherViews();
+        /*  -returns true if the document is also shown in another editor */
+
+        void recoverChanges(const EditJournal::Recovery& recovery);
+        /*
+        -applies the changes recovered from a journal to the document (which must be the journal's base), as a single undo action
+        -if the file is still being loaded, the changes are applied once it is loaded
+        */
+
         bool wasFileSaved();
         /* returns wheater changes to the open file have been saved/writen */
 
         QMenu* getLanguageMenu();
-        /* -returns the language selection menu */
+        /* -returns the language selection menu (the owner's, for another view of a document, since its lexer styles the document) */
 
     public slots:
         void changeTabsToSpaces();
@@ -103,11 +187,171 @@ class ScintillaEditor : public QsciScintilla
         void removeTrailingSpaces();
         /*  remove the spaces at the end of each line */
 
+        void cancelLoading();
+        /*  -stops loading the file being loaded, leaving the editor empty */
+
+    signals:
+        void loadProgress(qint64 bytesLoaded, qint64 bytesTotal);
+        /*  -emitted each time a block of the file being loaded is added to the editor */
+
+        void loadFinished();
+        /*  -emitted when a file loaded progressively is completely loaded (or when loading it was canceled) */
+
+        void saveFailed(const QString& filePath, const QString& errorString);
+        /*  -emitted when a file saved in the background could not be written */
+
     private:
         QFileInfo openFile;                     //path to file currently being edited
+        TextEncoding::Format fileFormat;        //encoding of the file being edited (the document itself is always UTF-8)
+        QTextDecoder* decoder;                  //decoder used to convert text added to the document (null if it is UTF-8)
         SyntaxHighlightManager* lexerManager;   //class to provide and manage the syntax highlighting lexer
+        QThread* loaderThread;                  //thread reading the file being loaded (null if no file is being loaded)
+        FileLoader* loader;                     //object reading the file being loaded, on `loaderThread`
+        qint64 bytesLoaded;                     //number of bytes of the file being loaded already added to the editor
+        qint64 bytesToLoad;                     //size of the file being loaded
+        bool saveInProgress;                    //true while the document is being saved in the background
+        QString queuedSavePath;                 //file to save the document to once the save in progress is done (empty if none)
+        int queuedSaveTransforms;               //save transforms to apply when saving to `queuedSavePath`
+        quint64 changeCount;                    //number of times the text changed
+        quint64 snapshotChangeCount;            //value of `changeCount` when the snapshot being saved was taken
+        bool saveTransformsSkipped;             //true if the save transforms changed the snapshot being saved but could not be applied to the document
+        int modifiedLineMarker;                 //invisible marker tagging the lines changed since the file was loaded (-1 if none was available)
+        bool reloading;                         //true while the document is updated to the contents of its file
+        QString watchedFilePath;                //file watched for changes made by other programs (empty if none)
+        QDateTime knownFileModified;            //last modification time of the file when it was last loaded, saved or checked
+        qint64 knownFileSize;                   //size of the file when it was last loaded, saved or checked (-1 if it did not exist)
+        QTimer fileCheckTimer;                  //timer used to check the file once it stopped changing
+        EditJournal* journal;                   //journal of the changes which were not saved
+        qint64 journalMark;                     //amount of changes journaled when the snapshot being saved was taken
+        QList<EditJournal::Recovery> pendingRecoveries; //changes to recover once the file being loaded is loaded
+        ScintillaEditor* primaryView;           //owner of the document, if this editor is another view of it (null otherwise)
+        QList<ScintillaEditor*> secondaryViews; //other views of the document owned by this editor
+        bool loadDeferred;                      //true if `openFile` was not loaded yet (see `deferLoading()`)
+        int deferredLine;                       //line to move the caret to once the deferred file is loaded
+        int deferredIndex;                      //index (in the line) to move the caret to once the deferred file is loaded
+        bool following;                         //true if text appended to the file is appended to the document (see `setFollowing()`)
+        qint64 followOffset;                    //offset in the file up to which it was read into the followed document
+        bool followDiscarded;                   //true if text was discarded from the start of the followed document (it is then not the whole file)
 
         void setModified(bool m) { QsciScintilla::setModified(m); }    //make method private
+
+        void configureForLongLines(int longestLine = -1);
+        /*
+            -adjusts layout caching and line wrapping depending on whether the document contains very long lines
+            -`longestLine` is the length of the longest line, if it is already known (-1 otherwise)
+        */
+
+        void convertIndentation(bool useTabs);
+        /*
+            -rewrites the indentation at the start of every line using tabs (followed by spaces up to the indentation
+             column) if `useTabs` is true, or using only spaces otherwise
+        */
+
+        void detectFormatting();
+        /*  -sets the line ending mode and the indentation used by the editor to the ones used in the document */
+
+        bool loadMapped(QFile& file);
+        /*
+            -sets the text in the editor to the contents of `file`, read from a memory map
+            -returns false, leaving the editor unchanged, if the file can not be mapped into memory
+        */
+
+        void setDocumentBytes(const uchar* data, qint64 size);
+        /*  -sets the text in the editor to the `size` bytes of a file at `data`, converting them to UTF-8 if they are encoded otherwise */
+
+        void startDecoding();
+        /*  -prepares to add text encoded in `fileFormat` to the document */
+
+        void appendEncoded(const char* data, qint64 size);
+        /*  -adds `size` bytes of text, encoded in `fileFormat`, to the end of the document (`startDecoding()` must be called first) */
+
+        void finishDecoding();
+        /*  -deletes the decoder used to convert text added to the document */
+
+        QByteArray encodedText();
+        /*
+            -returns the text converted to the encoding of the file (including its byte order mark)
+            -if some characters can not be represented in that encoding, the file is switched to UTF-8 instead of losing them
+        */
+
+        void loadPrefetched(const PrefetchJob::Contents& contents);
+        /*  -sets the text in the editor to the contents of a file read in the background, and makes it the file being edited */
+
+        void startLoading(const QString& filePath, qint64 fileSize);
+        /*  -starts loading a file progressively, from a worker thread */
+
+        void stopLoader();
+        /*  -stops the thread reading the file being loaded and deletes the loader */
+
+        void clearModifiedLines();
+        /*  -forgets which lines were modified (ex. once a file was loaded) */
+
+        SaveTransforms::Options saveTransformOptions(int transforms, bool onlyModifiedLines);
+        /*
+            -returns the options to apply `transforms` to the document with the line ending and indentation set in the editor
+            -if `onlyModifiedLines` is true, lines which were not changed since the file was loaded are not stripped or re-indented
+        */
+
+        void watchOpenFile();
+        /*
+            -watches the file being edited (if any) for changes made by other programs, and stops watching the one watched before
+            -the current state of the file is recorded as the one known to the editor
+        */
+
+        void rebaseJournal();
+        /*  -discards the changes journaled so far, since the document is now the same as its file (or empty, if it has none) */
+
+        void updateViews();
+        /*  -sets the line layout of the other views of the document to match the file loaded (their language follows this editor's) */
+
+        void handOverDocument();
+        /*  -makes another view of the document its owner, since this editor is being closed */
+
+        bool reloadFromDisk();
+        /*
+            -updates the document to the contents of its file, replacing only the lines which changed (as a single undo action)
+            -returns false if the file could not be read
+        */
+
+        void applyEdits(const SaveTransforms::EditList& edits);
+        /*  -applies `edits` (in increasing order of position) to the document, as a single undo action */
+
+        void readAppendedText();
+        /*  -appends the text added to the followed file since it was last read to the document, discarding old text past the memory cap */
+
+        void discardHead(qint64 keepLength);
+        /*  -removes whole lines from the start of the document so that (about) its last `keepLength` bytes are left */
+
+    private slots:
+        void appendBlock(const QByteArray& block);
+        /*  -adds a block of the file being loaded to the end of the document */
+
+        void loadingDone();
+        /*  -called when the whole file being loaded was read, to make the document editable */
+
+        void loadingFailed(const QString& errorString);
+        /*  -called if the file being loaded could not be read */
+
+        void countChange();
+        /*  -records that the text changed */
+
+        void markModifiedLines(int position, int modificationType, const char* text, int length, int linesAdded);
+        /*  -tags the lines changed by a modification of the document (text added while loading a file is not recorded for undo, and not tagged) */
+
+        void journalModification(int position, int modificationType, const char* text, int length);
+        /*  -adds a modification of the document to the journal (text added while loading or reloading a file is not journaled) */
+
+        void watchedFileChanged(const QString& filePath);
+        /*  -called when a watched file was changed, replaced or removed by another program */
+
+        void checkOpenFile();
+        /*  -reloads the file being edited if it was changed by another program (asking first if the document has unsaved changes) */
+
+        void applySaveTransforms(const SaveTransforms::EditList& edits, bool savedAsUtf8);
+        /*  -applies the edits made by the save transforms to the document, so that it is the same as the file written */
+
+        void backgroundSaveFinished(const QString& filePath, bool succeeded, const QString& errorString);
+        /*  -called when a file saved in the background was written (or could not be) */
 };
 
 #endif // SCINTILLAEDITOR_H
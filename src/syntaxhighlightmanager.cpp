@@ -47,6 +47,8 @@ Usage Agreement:
 #include <QDomDocument>
 #include <QDomElement>
 #include <QRegularExpression>
+#include <QScrollBar>
+#include <QElapsedTimer>
 
 //include QScintilla classes
 #include <Qsci/qscilexercss.h>
@@ -57,10 +59,132 @@ Usage Agreement:
 
 //include Lepton files used for this class implementation
 #include "leptonconfig.h"
-
-
-
-//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+#include "grammarregistry.h"
+
+
+
+//~style mappings of native lexers~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/*#############################################################################################
+### The following tables map the styles of the native QScintilla lexers to the style classes ##
+### used by the Lepton language files for the same kinds of tokens (ex. keywords use class 1,##
+### comments class 4, strings class 6, etc.).  This way, text highlighted by a native lexer  ##
+### looks the same as text highlighted by the Lepton lexer, using the current styling file.  ##
+#############################################################################################*/
+
+static const SyntaxHighlightManager::StyleMapping javaScriptStyles[] = {
+    {QsciLexerJavaScript::Comment, 4},
+    {QsciLexerJavaScript::CommentLine, 4},
+    {QsciLexerJavaScript::CommentDoc, 4},
+    {QsciLexerJavaScript::CommentLineDoc, 4},
+    {QsciLexerJavaScript::CommentDocKeyword, 4},
+    {QsciLexerJavaScript::CommentDocKeywordError, 4},
+    {QsciLexerJavaScript::Number, 8},
+    {QsciLexerJavaScript::Keyword, 1},
+    {QsciLexerJavaScript::KeywordSet2, 2},
+    {QsciLexerJavaScript::DoubleQuotedString, 6},
+    {QsciLexerJavaScript::SingleQuotedString, 6},
+    {QsciLexerJavaScript::UnclosedString, 6},
+    {QsciLexerJavaScript::VerbatimString, 6},
+    {QsciLexerJavaScript::Regex, 7},
+    {QsciLexerJavaScript::PreProcessor, 9}
+};
+
+static const SyntaxHighlightManager::StyleMapping htmlStyles[] = {
+    {QsciLexerHTML::Tag, 10},
+    {QsciLexerHTML::UnknownTag, 10},
+    {QsciLexerHTML::XMLTagEnd, 10},
+    {QsciLexerHTML::Script, 10},
+    {QsciLexerHTML::Attribute, 11},
+    {QsciLexerHTML::UnknownAttribute, 11},
+    {QsciLexerHTML::HTMLNumber, 6},
+    {QsciLexerHTML::HTMLDoubleQuotedString, 6},
+    {QsciLexerHTML::HTMLSingleQuotedString, 6},
+    {QsciLexerHTML::HTMLValue, 6},
+    {QsciLexerHTML::HTMLComment, 4},
+    {QsciLexerHTML::Entity, 2},
+    {QsciLexerHTML::XMLStart, 5},
+    {QsciLexerHTML::XMLEnd, 5},
+    {QsciLexerHTML::SGMLDefault, 5},
+    {QsciLexerHTML::SGMLCommand, 5},
+    {QsciLexerHTML::SGMLParameter, 5},
+    {QsciLexerHTML::SGMLDoubleQuotedString, 6},
+    {QsciLexerHTML::SGMLSingleQuotedString, 6},
+    {QsciLexerHTML::SGMLComment, 4},
+    {QsciLexerHTML::JavaScriptStart, 10},
+    {QsciLexerHTML::JavaScriptComment, 4},
+    {QsciLexerHTML::JavaScriptCommentLine, 4},
+    {QsciLexerHTML::JavaScriptCommentDoc, 4},
+    {QsciLexerHTML::JavaScriptNumber, 8},
+    {QsciLexerHTML::JavaScriptKeyword, 1},
+    {QsciLexerHTML::JavaScriptDoubleQuotedString, 6},
+    {QsciLexerHTML::JavaScriptSingleQuotedString, 6},
+    {QsciLexerHTML::JavaScriptUnclosedString, 6},
+    {QsciLexerHTML::JavaScriptRegex, 7},
+    {QsciLexerHTML::PHPStart, 3},
+    {QsciLexerHTML::PHPDefault, 3},
+    {QsciLexerHTML::PHPKeyword, 3},
+    {QsciLexerHTML::PHPNumber, 3},
+    {QsciLexerHTML::PHPVariable, 3},
+    {QsciLexerHTML::PHPOperator, 3},
+    {QsciLexerHTML::PHPDoubleQuotedString, 6},
+    {QsciLexerHTML::PHPSingleQuotedString, 6},
+    {QsciLexerHTML::PHPDoubleQuotedVariable, 6},
+    {QsciLexerHTML::PHPComment, 4},
+    {QsciLexerHTML::PHPCommentLine, 4}
+};
+
+static const SyntaxHighlightManager::StyleMapping xmlStyles[] = {
+    {QsciLexerXML::Tag, 10},
+    {QsciLexerXML::UnknownTag, 10},
+    {QsciLexerXML::XMLTagEnd, 10},
+    {QsciLexerXML::Attribute, 11},
+    {QsciLexerXML::UnknownAttribute, 11},
+    {QsciLexerXML::HTMLDoubleQuotedString, 6},
+    {QsciLexerXML::HTMLSingleQuotedString, 6},
+    {QsciLexerXML::HTMLValue, 6},
+    {QsciLexerXML::HTMLComment, 4},
+    {QsciLexerXML::Entity, 2},
+    {QsciLexerXML::XMLStart, 5},
+    {QsciLexerXML::XMLEnd, 5}
+};
+
+static const SyntaxHighlightManager::StyleMapping cssStyles[] = {
+    {QsciLexerCSS::Tag, 10},
+    {QsciLexerCSS::ClassSelector, 11},
+    {QsciLexerCSS::IDSelector, 11},
+    {QsciLexerCSS::Attribute, 11},
+    {QsciLexerCSS::PseudoClass, 12},
+    {QsciLexerCSS::UnknownPseudoClass, 12},
+    {QsciLexerCSS::PseudoElement, 12},
+    {QsciLexerCSS::CSS1Property, 1},
+    {QsciLexerCSS::CSS2Property, 1},
+    {QsciLexerCSS::CSS3Property, 1},
+    {QsciLexerCSS::UnknownProperty, 1},
+    {QsciLexerCSS::Value, 8},
+    {QsciLexerCSS::Comment, 4},
+    {QsciLexerCSS::Important, 9},
+    {QsciLexerCSS::AtRule, 9},
+    {QsciLexerCSS::DoubleQuotedString, 6},
+    {QsciLexerCSS::SingleQuotedString, 6}
+};
+
+static const SyntaxHighlightManager::StyleMapping yamlStyles[] = {
+    {QsciLexerYAML::Comment, 4},
+    {QsciLexerYAML::Identifier, 11},
+    {QsciLexerYAML::Keyword, 1},
+    {QsciLexerYAML::Number, 8},
+    {QsciLexerYAML::Reference, 2},
+    {QsciLexerYAML::DocumentDelimiter, 9},
+    {QsciLexerYAML::TextBlockMarker, 6},
+    {QsciLexerYAML::SyntaxErrorMarker, 7}
+};
+
+#define STYLE_MAPPING_COUNT(mappings) ( sizeof(mappings) / sizeof(SyntaxHighlightManager::StyleMapping) )
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 SyntaxHighlightManager::SyntaxHighlightManager(QsciScintilla* _parent) : QObject((QObject*)_parent) {
 /* -Class constructor */
@@ -68,6 +192,7 @@ SyntaxHighlightManager::SyntaxHighlightManager(QsciScintilla* _parent) : QObject
     //initialize private data members
     parent = _parent;                   //initialize parent object to the editor
     lexer = new LeptonLexer();
+    connect(lexer, SIGNAL(stylesLoaded()), this, SLOT(leptonStylesLoaded()));
     languageMenu = new QMenu("Language");
     languageActions = new QActionGroup(languageMenu);
     parent->setLexer(lexer);
@@ -86,6 +211,33 @@ SyntaxHighlightManager::SyntaxHighlightManager(QsciScintilla* _parent) : QObject
     plainTextAction->setData( QString() );
     specialActionList.append(plainTextAction);
 
+    /*##########################################################################################
+    ### QScintilla provides native lexers for some languages.  They are much faster than the  ##
+    ### Lepton lexer (their rules are compiled into the library) so they are used for the     ##
+    ### languages which have no language file and, if the user enables it, in place of the   ##
+    ### Lepton lexer for the languages they are equivalent to.                                ##
+    ##########################################################################################*/
+
+    QsciLexer* cssLexer = new QsciLexerCSS(this);
+    mapStylesOnto(cssLexer, cssStyles, STYLE_MAPPING_COUNT(cssStyles));
+    addSpecialLanguage(specialActionList, "CSS", cssLexer, "css");
+
+    QsciLexer* yamlLexer = new QsciLexerYAML(this);
+    mapStylesOnto(yamlLexer, yamlStyles, STYLE_MAPPING_COUNT(yamlStyles));
+    addSpecialLanguage(specialActionList, "YAML", yamlLexer, "yaml yml");
+
+    QsciLexer* nativeLexer = new QsciLexerJavaScript(this);
+    mapStylesOnto(nativeLexer, javaScriptStyles, STYLE_MAPPING_COUNT(javaScriptStyles));
+    equivalentLexers.insert("javascript.xml", nativeLexer);
+
+    nativeLexer = new QsciLexerHTML(this);
+    mapStylesOnto(nativeLexer, htmlStyles, STYLE_MAPPING_COUNT(htmlStyles));
+    equivalentLexers.insert("html_php.xml", nativeLexer);
+
+    nativeLexer = new QsciLexerXML(this);
+    mapStylesOnto(nativeLexer, xmlStyles, STYLE_MAPPING_COUNT(xmlStyles));
+    equivalentLexers.insert("xml.xml", nativeLexer);
+
     //add special actions to the menu
     languageMenu->addActions(specialActionList);
 
@@ -94,7 +246,25 @@ SyntaxHighlightManager::SyntaxHighlightManager(QsciScintilla* _parent) : QObject
         getLanguages(languagesDir, languageMenu);
     }
 
+    //define the action used to enable native lexers in place of equivalent language files
+    languageMenu->addSeparator();
+    nativeLexersAction = languageMenu->addAction("Use Native Lexers When Available");
+    nativeLexersAction->setCheckable(true);
+    nativeLexersAction->setChecked( LeptonConfig::mainSettings->getValueOrDefault(false, "syntax_highlighting", "native_lexers").toBool() );
+
+    //setup background restyling
+    restylePosition = 0;
+    provisionalStart = provisionalEnd = 0;
+    stylingManager = 0;
+    restyleTimer.setInterval(0);
+    connect(&restyleTimer, SIGNAL(timeout()), this, SLOT(continueRestyling()));
+    connect(parent->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(restyleVisibleLines()));
+
+    //reload the language when its file changes
+    connect(GrammarRegistry::getRegistry(), SIGNAL(languageChanged(QString)), this, SLOT(languageFileChanged(QString)));
+
     connect(languageActions, SIGNAL(triggered(QAction*)), this, SLOT(languageSelected(QAction*)));
+    connect(nativeLexersAction, SIGNAL(toggled(bool)), this, SLOT(nativeLexersToggled(bool)));
 }
 
 
@@ -113,6 +283,12 @@ QMenu* SyntaxHighlightManager::getLanguageMenu() {
     return languageMenu;
 }
 
+QString SyntaxHighlightManager::getLanguageName() {
+/*  -returns the name of the language selected */
+    QAction* a = languageActions->checkedAction();
+    return a != 0 ? a->text() : plainTextAction->text();
+}
+
 QString SyntaxHighlightManager::setLexerForFile(const QString& fileName) {
 /*
 -sets an appropriate lexer for `fileName` based on filemasks
@@ -128,7 +304,7 @@ QString SyntaxHighlightManager::setLexerForFile(const QString& fileName) {
         }
     }
 
-    lexer->loadLanguage( a->data().toString() );
+    applyLanguage(a);
     a->setChecked(true);
     emit changedLexerLanguage( a->text() );
     return a->text();
@@ -139,10 +315,158 @@ QString SyntaxHighlightManager::setLexerForFile(const QString& fileName) {
     ###############################################################################*/
 }
 
+void SyntaxHighlightManager::restyleProgressively() {
+/*
+-restyles the whole document without blocking: the visible lines are restyled immediately
+ and the rest of the text is restyled in the background (or when it is scrolled into view)
+-used when the language or the styles of the lexer change
+*/
+    restyleTimer.stop();
+    if (stylingManager != 0) return;    //the document is restyled by the view which styles it
+
+    if (parent->lexer() != lexer) {
+        //native lexers are fast enough to style any part of the text on demand, so Scintilla
+        //  is simply told that nothing is styled and restyles the lines as they are displayed
+        parent->SendScintilla(QsciScintillaBase::SCI_STARTSTYLING, 0, 0);
+        parent->viewport()->update();
+        return;
+    }
+
+    /*##########################################################################################
+    ### Restyling the whole document with the Lepton lexer can take seconds for large files. ##
+    ### Instead, the text is restyled a bit at a time, from the start, whenever the event    ##
+    ### loop is idle.  Lines scrolled into view before the background restyling reaches them ##
+    ### are restyled immediately (see `restyleVisibleLines()`).                              ##
+    ##########################################################################################*/
+
+    restylePosition = 0;
+    provisionalStart = provisionalEnd = 0;
+    restyleTimer.start();
+    restyleVisibleLines();
+}
+
+void SyntaxHighlightManager::textRemovedFromStart(int length) {
+/*  -tells the lexer that `length` bytes were removed from the start of the document (the text left keeps its styling) */
+    restylePosition = qMax(0, restylePosition - length);
+    provisionalStart = qMax(0, provisionalStart - length);
+    provisionalEnd = qMax(0, provisionalEnd - length);
+    if (parent->lexer() == lexer && stylingManager == 0) lexer->discardRuleStacksBefore(length);    //native lexers keep their state in the lines themselves
+}
+
+void SyntaxHighlightManager::showStylesOf(SyntaxHighlightManager* manager) {
+/*
+-makes the editor display its document as it is styled by `manager`, the manager of another view of the same
+ document: the language selected in `manager` is used, and the lexer of this manager stops styling the text
+-if `manager` is 0, the lexer of this manager styles the document again (ex. once the view which styled it is closed)
+*/
+
+    /*#########################################################################################
+    ### The styles of a document are shared by all of its views, but the Lepton lexer keeps ##
+    ### the rule stacks it needs to restyle part of the text for itself.  If every view     ##
+    ### styled the text, each lexer would restyle it from stacks which do not match the     ##
+    ### edits made in the other views.  So only one view's lexer styles the document (when  ##
+    ### a view needs text styled, Scintilla asks every view until one styles it).  The      ##
+    ### other views select the same language, since the colors and fonts of the styles      ##
+    ### belong to each view, and their lexer does nothing.                                   ##
+    #########################################################################################*/
+
+    if (stylingManager != 0) disconnect(stylingManager, SIGNAL(changedLexerLanguage(QString)), this, SLOT(stylingLanguageChanged()));
+    stylingManager = manager;
+    restyleTimer.stop();
+    lexer->setStylingEnabled(stylingManager == 0);
+
+    if (stylingManager != 0) {
+        connect(stylingManager, SIGNAL(changedLexerLanguage(QString)), this, SLOT(stylingLanguageChanged()));
+        stylingLanguageChanged();
+    }
+    else restyleProgressively();    //the lexer did not keep its rule stacks while the text was styled by another one
+}
+
 
 
 //~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+void SyntaxHighlightManager::addSpecialLanguage(QList<QAction*>& aList, const QString& name, QsciLexer* lexer, const QString& extList) {
+/*  -add a special language lexer to the list using its name, lexer, and file extension (suffix) list */
+    QAction* langAction = languageActions->addAction(name);
+    langAction->setCheckable(true);
+    langAction->setChecked(false);
+    langAction->setData( QString() );
+    aList.append(langAction);
+    specialLexers.insert(langAction, lexer);
+
+    //match files using the extensions in the (space separated) list
+    FilemaskActionPair newPair;
+    newPair.filemask.setPattern( QString(".*\\.(%1)$").arg( extList.simplified().replace(' ', '|') ) );
+    if ( newPair.filemask.isValid() ) {
+        newPair.langAction = langAction;
+        filemaskList.append(newPair);
+    }
+}
+
+void SyntaxHighlightManager::mapStylesOnto(QsciLexer* nativeLexer, const StyleMapping* mappings, int count) {
+/*
+-sets the style of every style used by `nativeLexer` to that of the Lepton style class it is mapped
+ to in `mappings`, so that native lexers are displayed using the current styling file
+-styles which are not mapped are displayed using style class 0
+-the mappings are kept so that they are applied again whenever the Lepton lexer loads its styles
+*/
+    styleMappings.insert( nativeLexer, qMakePair(mappings, count) );
+
+    nativeLexer->setDefaultPaper( lexer->defaultPaper() );
+    nativeLexer->setDefaultColor( lexer->defaultColor() );
+    nativeLexer->setDefaultFont( lexer->defaultFont() );
+
+    for (int style = 0; style < 128; style++) {
+        if ( nativeLexer->description(style).isEmpty() ) continue;  //the style is not used by the lexer
+
+        int leptonStyle = 0;
+        for (int i = 0; i < count; i++) {
+            if (mappings[i].nativeStyle == style) leptonStyle = mappings[i].leptonStyle;
+        }
+
+        nativeLexer->setColor( lexer->color(leptonStyle), style );
+        nativeLexer->setPaper( lexer->paper(leptonStyle), style );
+        nativeLexer->setFont( lexer->font(leptonStyle), style );
+        nativeLexer->setEolFill( false, style );
+    }
+}
+
+void SyntaxHighlightManager::applyLanguage(QAction* langAction) {
+/*  -sets the lexer (and its language) used by the editor for the language of `langAction` */
+    QsciLexer* nativeLexer = specialLexers.value(langAction, 0);
+
+    QString languageFile = langAction->data().toString();
+    if ( nativeLexer == 0 && nativeLexersAction->isChecked() && ! languageFile.isEmpty() )
+        nativeLexer = equivalentLexers.value( QFileInfo(languageFile).fileName(), 0 );
+
+    if (nativeLexer != 0) {
+        if (parent->lexer() != nativeLexer) parent->setLexer(nativeLexer);
+    }
+    else {
+        lexer->loadLanguage(languageFile);
+        if (parent->lexer() != lexer) parent->setLexer(lexer);
+    }
+}
+
+int SyntaxHighlightManager::restyleRange(int start, int end) {
+/*
+-styles the text from `start` to `end` using the Lepton lexer, without changing which part
+ of the document Scintilla considers to be already styled
+-returns the position up to which text was styled
+*/
+    int endStyled = parent->SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+
+    lexer->startStyling(start);
+    lexer->styleText(start, end);
+    int styledTo = parent->SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+
+    //text after `styledTo` is still styled (with the previous styles) so Scintilla must not restyle it
+    if (endStyled > styledTo) lexer->startStyling(endStyled);
+
+    return styledTo;
+}
+
 void SyntaxHighlightManager::getLanguages(const QDir& langDir, QMenu* langMenu) {
 /*  -adds a language selection action to `langMenu` for each language defined by a file in `langDir` */
     if ( ! langDir.exists() || ! langDir.isReadable() ) return;
@@ -201,7 +525,125 @@ void SyntaxHighlightManager::getLanguages(const QDir& langDir, QMenu* langMenu)
 
 void SyntaxHighlightManager::languageSelected(QAction* langAction) {
 /*  -responds to 'langAction' being clicked in the language menu and emits a signal to change the lexer language */
-    lexer->loadLanguage( langAction->data().toString() );
-    parent->recolor();
+    applyLanguage(langAction);
+    restyleProgressively();
+    emit changedLexerLanguage( langAction->text() );
+}
+
+void SyntaxHighlightManager::nativeLexersToggled(bool enabled) {
+/*  -re-applies the current language after native lexers are enabled or disabled */
+    Q_UNUSED(enabled);
+    QAction* currentAction = languageActions->checkedAction();
+    if (currentAction != 0) languageSelected(currentAction);
+}
+
+void SyntaxHighlightManager::languageFileChanged(const QString& filePath) {
+/*  -reloads the current language, and restyles the document, if its language file changed */
+    QAction* currentAction = languageActions->checkedAction();
+    if ( currentAction == 0 || parent->lexer() != lexer ) return;
+    if ( QFileInfo( currentAction->data().toString() ).absoluteFilePath() != filePath ) return;
+
+    applyLanguage(currentAction);
+    restyleProgressively();
+}
+
+void SyntaxHighlightManager::restyleVisibleLines() {
+/*  -styles the visible lines which the background restyling has not reached yet, spending at most a time slice doing so */
+    if ( ! restyleTimer.isActive() ) return;   //the whole document is already restyled
+
+    const int timeSlice = 10;           //maximum time (in milliseconds) spent styling the visible lines
+    const int catchUpDistance = 4096;   //distance (in bytes) from which the background restyling catches up with the visible lines
+
+    int firstLine = parent->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                          parent->SendScintilla(QsciScintillaBase::SCI_GETFIRSTVISIBLELINE));
+    int lastLine = parent->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                         parent->SendScintilla(QsciScintillaBase::SCI_GETFIRSTVISIBLELINE)
+                                         + parent->SendScintilla(QsciScintillaBase::SCI_LINESONSCREEN));
+    int start = parent->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE, firstLine);
+    int end = parent->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, lastLine);
+
+    if (end <= restylePosition) return;                                 //the visible lines are already restyled
+    if (start >= provisionalStart && end <= provisionalEnd) return;     //the visible lines were already styled ahead of the background restyling
+
+    /*##########################################################################################
+    ### The rule stacks saved by the lexer are reset when the language changes, so the only   ##
+    ### ones which are right are those saved before `restylePosition`.  When the visible      ##
+    ### lines are close to it, they are restyled from there.  Otherwise, they are styled      ##
+    ### right away from the stack saved at their start (the root rule list, unless they       ##
+    ### were already styled this way), which is wrong only if a span (block comment, string,  ##
+    ### etc.) is open there.  These provisional styles are fixed once the background          ##
+    ### restyling reaches them: the lexer keeps going for as long as the stacks it finds      ##
+    ### differ from the saved ones.  Scrolling through a large file therefore never waits     ##
+    ### for all the text before the visible lines to be styled.                               ##
+    ##########################################################################################*/
+
+    bool catchingUp = start <= restylePosition + catchUpDistance;
+    int position = restylePosition;
+    if ( ! catchingUp ) {
+        //carry on from provisional styles which end within the visible lines
+        position = (start >= provisionalStart && start < provisionalEnd) ? provisionalEnd : start;
+        if (position != provisionalEnd) provisionalStart = position;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (position < end && timer.elapsed() < timeSlice) {
+        int styledTo = restyleRange(position, end);
+
+        //very long lines are styled one window at a time, so `styledTo` may be before `end`
+        position = styledTo > position ? styledTo : end + 1;
+    }
+
+    if (catchingUp) restylePosition = position;
+    else provisionalEnd = position;
+
+    if ( restylePosition >= parent->length() ) restyleTimer.stop();
+}
+
+void SyntaxHighlightManager::continueRestyling() {
+/*  -restyles the next part of the document in the background */
+    const int timeSlice = 10;   //maximum time (in milliseconds) spent restyling before returning to the event loop
+    const int lineBlock = 64;   //number of lines restyled at a time
+
+    int length = parent->length();
+    QElapsedTimer timer;
+    timer.start();
+
+    while (restylePosition < length && timer.elapsed() < timeSlice) {
+        int line = parent->SendScintilla(QsciScintillaBase::SCI_LINEFROMPOSITION, restylePosition);
+        int end = parent->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION, line + lineBlock);
+
+        int styledTo = restyleRange(restylePosition, end);
+
+        //very long lines are styled one window at a time, so `styledTo` may be before `end`
+        restylePosition = styledTo > restylePosition ? styledTo : end + 1;
+    }
+
+    if (restylePosition >= length) restyleTimer.stop();
+}
+
+void SyntaxHighlightManager::leptonStylesLoaded() {
+/*  -applies the style mappings of the native lexers again, after the Lepton lexer loaded new styles */
+    foreach (QsciLexer* nativeLexer, styleMappings.keys()) {
+        QPair<const StyleMapping*, int> mapping = styleMappings.value(nativeLexer);
+        mapStylesOnto(nativeLexer, mapping.first, mapping.second);
+    }
+}
+
+void SyntaxHighlightManager::stylingLanguageChanged() {
+/*  -selects the language used by the manager which styles the document, so that the text is displayed with the same styles */
+    if (stylingManager == 0) return;
+
+    //every manager has the same language actions, in the same order
+    int index = stylingManager->languageActions->actions().indexOf( stylingManager->languageActions->checkedAction() );
+    QAction* langAction = languageActions->actions().value(index, plainTextAction);
+
+    nativeLexersAction->blockSignals(true);
+    nativeLexersAction->setChecked( stylingManager->nativeLexersAction->isChecked() );
+    nativeLexersAction->blockSignals(false);
+
+    applyLanguage(langAction);
+    langAction->setChecked(true);
     emit changedLexerLanguage( langAction->text() );
 }
@@ -47,6 +47,9 @@ Usage Agreement:
 #include <QList>
 #include <QStringList>
 #include <QDir>
+#include <QHash>
+#include <QPair>
+#include <QTimer>
 
 //include QScintilla classes
 #include <Qsci/qsciscintilla.h>
@@ -63,6 +66,11 @@ class SyntaxHighlightManager : public QObject{
     Q_OBJECT
 
     public:
+        struct StyleMapping {
+                int nativeStyle;    //style number used by a QScintilla lexer
+                int leptonStyle;    //style class (as defined in the styling files) used to display it
+        };
+
         explicit SyntaxHighlightManager(QsciScintilla *_parent);
         /*
             -Class constructor
@@ -78,12 +86,32 @@ class SyntaxHighlightManager : public QObject{
         QMenu* getLanguageMenu();
         /*  -access function to get the language menu created from the language actions */
 
+        QString getLanguageName();
+        /*  -returns the name of the language selected */
+
         QString setLexerForFile(const QString& fileName);
         /*
             -sets an appropriate lexer for `fileName` based on filemasks
             -returns the name of the language selected
         */
 
+        void restyleProgressively();
+        /*
+            -restyles the whole document without blocking: the visible lines are restyled immediately
+             and the rest of the text is restyled in the background (or when it is scrolled into view)
+            -used when the language or the styles of the lexer change
+        */
+
+        void textRemovedFromStart(int length);
+        /*  -tells the lexer that `length` bytes were removed from the start of the document (the text left keeps its styling) */
+
+        void showStylesOf(SyntaxHighlightManager* manager);
+        /*
+            -makes the editor display its document as it is styled by `manager`, the manager of another view of the same
+             document: the language selected in `manager` is used, and the lexer of this manager stops styling the text
+            -if `manager` is 0, the lexer of this manager styles the document again (ex. once the view which styled it is closed)
+        */
+
     signals:
         void changedLexerLanguage(const QString& langName);
         /*  -a signal emited when the language grammer of the lexer is changed */
@@ -94,23 +122,67 @@ class SyntaxHighlightManager : public QObject{
                 QRegularExpression filemask;
                 QAction* langAction;
         };
-
         QsciScintilla* parent;                  //pointer the editing class which uses this manager
         QActionGroup* languageActions;          //a group of actions to use for selecting a syntax highlighting language
         QMenu* languageMenu;                    //a menu to select a language
         QAction* plainTextAction;               //action to set highlighting for plain text document
         LeptonLexer* lexer;                     //the lexer used for languages defined in files
         QList<FilemaskActionPair> filemaskList; //a table to match file names to a language action
+        QAction* nativeLexersAction;            //action to enable or disable the use of native QScintilla lexers
+        QHash<QAction*, QsciLexer*> specialLexers;      //native lexers used for languages which have no language file
+        QHash<QString, QsciLexer*> equivalentLexers;    //native lexers equivalent to a language file (indexed by file name)
+        QHash< QsciLexer*, QPair<const StyleMapping*, int> > styleMappings; //style mappings (and their count) of each native lexer
+        QTimer restyleTimer;                    //timer used to restyle the document in the background
+        int restylePosition;                    //position up to which the document was restyled in the background
+        int provisionalStart;                   //start of the visible text styled ahead of the background restyling
+        int provisionalEnd;                     //end of the visible text styled ahead of the background restyling
+        SyntaxHighlightManager* stylingManager; //manager of the view of the document whose lexer styles it (0 if it is this one)
 
         void addSpecialLanguage(QList<QAction*>& aList, const QString& name, QsciLexer* lexer, const QString& extList);
         /*  -add a special language lexer to the list using its name, lexer, and file extension (suffix) list */
 
+        void mapStylesOnto(QsciLexer* nativeLexer, const StyleMapping* mappings, int count);
+        /*
+            -sets the style of every style used by `nativeLexer` to that of the Lepton style class it is mapped
+             to in `mappings`, so that native lexers are displayed using the current styling file
+            -styles which are not mapped are displayed using style class 0
+            -the mappings are kept so that they are applied again whenever the Lepton lexer loads its styles
+        */
+
+        void applyLanguage(QAction* langAction);
+        /*  -sets the lexer (and its language) used by the editor for the language of `langAction` */
+
+        int restyleRange(int start, int end);
+        /*
+            -styles the text from `start` to `end` using the Lepton lexer, without changing which part
+             of the document Scintilla considers to be already styled
+            -returns the position up to which text was styled
+        */
+
         void getLanguages(const QDir& langDir, QMenu* langMenu);
         /*  -adds a language selection action to `langMenu` for each language defined by a file in `langDir` */
 
     private slots:
         void languageSelected(QAction* langAction);
         /*  -responds to 'langAction' being clicked in the language menu and emits a signal to change the lexer language */
+
+        void nativeLexersToggled(bool enabled);
+        /*  -re-applies the current language after native lexers are enabled or disabled */
+
+        void languageFileChanged(const QString& filePath);
+        /*  -reloads the current language, and restyles the document, if its language file changed */
+
+        void restyleVisibleLines();
+        /*  -styles the visible lines which the background restyling has not reached yet, spending at most a time slice doing so */
+
+        void continueRestyling();
+        /*  -restyles the next part of the document in the background */
+
+        void leptonStylesLoaded();
+        /*  -applies the style mappings of the native lexers again, after the Lepton lexer loaded new styles */
+
+        void stylingLanguageChanged();
+        /*  -selects the language used by the manager which styles the document, so that the text is displayed with the same styles */
 };
 
 #endif // SYNTAXHIGHLIGHTMANAGER_H
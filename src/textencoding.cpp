@@ -0,0 +1,312 @@
+/*
+Project: Lepton Editor
+File: textencoding.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the TextEncoding class.  It detects how the text
+    of a file is encoded and converts text between that encoding and UTF-8.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "textencoding.h"
+
+//include Qt classes
+#include <QTextDecoder>
+#include <QtAlgorithms>
+
+//include other standard library classes
+#include <cstring>
+
+//include SIMD intrinsics where they are available
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LEPTON_HAVE_SSE2
+#endif
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static qint64 asciiPrefixLength(const uchar* data, qint64 length) {
+/*  -returns the number of bytes at the start of `data` which are ASCII, checking several bytes at a time */
+    qint64 i = 0;
+
+#ifdef LEPTON_HAVE_SSE2
+    //check 16 bytes at a time: the high bit of every byte is collected into a mask
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + i) );
+        if ( _mm_movemask_epi8(chunk) != 0 ) break;
+    }
+#endif
+
+    for (; i + 8 <= length; i += 8) {
+        quint64 word;
+        std::memcpy(&word, data + i, 8);
+        if ( (word & Q_UINT64_C(0x8080808080808080)) != 0 ) break;
+    }
+
+    while (i < length && data[i] < 0x80) i++;
+    return i;
+}
+
+static bool isControlCharacter(uchar c) {
+/*  -returns true if `c` is a control character which is not found in text (zeros excluded) */
+    return c != 0 && c < 0x20 && c != '\t' && c != '\n' && c != '\r' && c != '\f' && c != '\v' && c != 0x1B;
+}
+
+static void countUnusualBytes(const uchar* data, qint64 length, qint64* zeros, qint64* controls) {
+/*  -counts the zero bytes and the control characters (see `isControlCharacter()`) in the `length` bytes at `data` */
+    qint64 i = 0;
+    *zeros = 0;
+    *controls = 0;
+
+#ifdef LEPTON_HAVE_SSE2
+    //check 16 bytes at a time: bytes matching a test are collected into a mask, whose bits are counted
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lastControl = _mm_set1_epi8(0x1F);
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lineFeed = _mm_set1_epi8('\n');
+    const __m128i verticalTab = _mm_set1_epi8('\v');
+    const __m128i formFeed = _mm_set1_epi8('\f');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i escape = _mm_set1_epi8(0x1B);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + i) );
+        __m128i isZero = _mm_cmpeq_epi8(chunk, zero);
+        __m128i isBelowSpace = _mm_cmpeq_epi8(_mm_min_epu8(chunk, lastControl), chunk);
+        __m128i isAllowed = _mm_or_si128( _mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, lineFeed)),
+                                          _mm_or_si128(_mm_cmpeq_epi8(chunk, verticalTab), _mm_cmpeq_epi8(chunk, formFeed)) );
+        isAllowed = _mm_or_si128( isAllowed, _mm_or_si128(_mm_cmpeq_epi8(chunk, carriageReturn), _mm_cmpeq_epi8(chunk, escape)) );
+        isAllowed = _mm_or_si128(isAllowed, isZero);
+
+        *zeros += qPopulationCount( quint32(_mm_movemask_epi8(isZero)) );
+        *controls += qPopulationCount( quint32(_mm_movemask_epi8( _mm_andnot_si128(isAllowed, isBelowSpace) )) );
+    }
+#endif
+
+    for (; i < length; i++) {
+        if (data[i] == 0) (*zeros)++;
+        else if ( isControlCharacter(data[i]) ) (*controls)++;
+    }
+}
+
+static qint64 invalidUtf8Count(const uchar* data, qint64 length) {
+/*  -returns the number of bytes in the `length` bytes at `data` which are not part of a valid UTF-8 character (a character cut at the end is ignored) */
+    qint64 invalid = 0;
+    qint64 i = 0;
+    while (i < length) {
+        i += asciiPrefixLength(data + i, length - i);
+        if (i >= length) break;
+
+        const uchar c = data[i];
+        int count = 0;
+        if (c >= 0xC2 && c <= 0xDF) count = 1;
+        else if (c >= 0xE0 && c <= 0xEF) count = 2;
+        else if (c >= 0xF0 && c <= 0xF4) count = 3;
+
+        bool valid = count > 0;
+        if (valid && i + count >= length) break;
+        for (int j = 1; valid && j <= count; j++) valid = (data[i + j] & 0xC0) == 0x80;
+
+        if (valid) i += count + 1;
+        else {
+            invalid++;
+            i++;
+        }
+    }
+    return invalid;
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+TextEncoding::Format TextEncoding::detect(const uchar* data, qint64 length, bool complete) {
+/*
+-returns the encoding of the `length` bytes at `data`
+-if `complete` is false, the bytes are only the start of the text (a character may be cut at the end)
+*/
+
+    /*##########################################################################################
+    ### The checks are made from the most to the least certain:                              ##
+    ###     (1) a byte order mark identifies the encoding                                      ##
+    ###     (2) text in UTF-16 has a zero in every other byte for (mostly) ASCII characters,  ##
+    ###         which almost never happens in text encoded in any other way                    ##
+    ###     (3) text which is not ASCII is very unlikely to be valid UTF-8 by chance           ##
+    ###     (4) anything else is read as Latin-1, which maps every byte to a character (so the ##
+    ###         file is saved back exactly as it was read)                                     ##
+    ### Only the first 64KiB are checked for zeros, so only validating UTF-8 reads the whole  ##
+    ### file, which is fast since most text is ASCII and ASCII is checked 16 bytes at a time. ##
+    ##########################################################################################*/
+
+    if (length >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF) return Format(Utf8, true);
+    if (length >= 2 && data[0] == 0xFF && data[1] == 0xFE) return Format(Utf16LE, true);
+    if (length >= 2 && data[0] == 0xFE && data[1] == 0xFF) return Format(Utf16BE, true);
+
+    const qint64 sampleLength = qMin(length, qint64(65536)) & ~qint64(1);
+    if (sampleLength >= 2) {
+        qint64 evenZeros = 0;
+        qint64 oddZeros = 0;
+        for (qint64 i = 0; i < sampleLength; i += 2) {
+            if (data[i] == 0) evenZeros++;
+            if (data[i + 1] == 0) oddZeros++;
+        }
+        const qint64 pairs = sampleLength / 2;
+        if (oddZeros * 10 > pairs * 3 && evenZeros * 20 < pairs) return Format(Utf16LE, false);
+        if (evenZeros * 10 > pairs * 3 && oddZeros * 20 < pairs) return Format(Utf16BE, false);
+    }
+
+    //a character cut at the end of an incomplete text is ignored
+    qint64 checkedLength = length;
+    if (! complete) {
+        for (qint64 i = length - 1; i >= 0 && i >= length - 3; i--) {
+            if ( (data[i] & 0xC0) != 0x80 ) {           //the first byte of the last character
+                if (data[i] >= 0xC0) checkedLength = i;
+                break;
+            }
+        }
+    }
+
+    if ( isValidUtf8(data, checkedLength) ) return Format(Utf8, false);
+    return Format(Latin1, false);
+}
+
+bool TextEncoding::isValidUtf8(const uchar* data, qint64 length) {
+/*  -returns true if the `length` bytes at `data` are valid UTF-8 (overlong forms and surrogates are rejected) */
+    qint64 i = 0;
+    while (i < length) {
+        //skip over runs of ASCII text several bytes at a time
+        i += asciiPrefixLength(data + i, length - i);
+        if (i >= length) break;
+
+        uchar c = data[i];
+        int count;              //number of continuation bytes
+        uchar lowest = 0x80;    //smallest allowed value of the first continuation byte
+        uchar highest = 0xBF;   //largest allowed value of the first continuation byte
+        if (c >= 0xC2 && c <= 0xDF) count = 1;
+        else if (c >= 0xE0 && c <= 0xEF) {
+            count = 2;
+            if (c == 0xE0) lowest = 0xA0;       //overlong encoding
+            else if (c == 0xED) highest = 0x9F; //UTF-16 surrogate
+        }
+        else if (c >= 0xF0 && c <= 0xF4) {
+            count = 3;
+            if (c == 0xF0) lowest = 0x90;       //overlong encoding
+            else if (c == 0xF4) highest = 0x8F; //beyond U+10FFFF
+        }
+        else return false;
+
+        if (i + count >= length) return false;     //truncated sequence
+        if (data[i + 1] < lowest || data[i + 1] > highest) return false;
+        for (int j = 2; j <= count; j++) {
+            if ( (data[i + j] & 0xC0) != 0x80 ) return false;
+        }
+        i += count + 1;
+    }
+    return true;
+}
+
+bool TextEncoding::looksBinary(const uchar* data, qint64 length) {
+/*  -returns true if the `length` bytes at `data` (ex. the start of a file) look like binary data rather than text */
+
+    /*##########################################################################################
+    ### Text hardly ever contains zero bytes (except in UTF-16, which `detect()` recognizes)   ##
+    ### or control characters other than whitespace, while most binary data is full of both.  ##
+    ### Compressed data, which has few of either, is mostly bytes which are not valid UTF-8.   ##
+    ### Text which is not UTF-8 (ex. Latin-1 or Cyrillic code pages) can also be mostly       ##
+    ### invalid UTF-8, so invalid UTF-8 only counts when there are control characters too.   ##
+    ### The zeros and control characters are counted 16 bytes at a time, and the check for   ##
+    ### invalid UTF-8 skips over runs of ASCII 16 bytes at a time.                            ##
+    ##########################################################################################*/
+
+    if (length <= 0) return false;
+    Format format = detect(data, length, false);
+    if (format.hasBom || format.encoding == Utf16LE || format.encoding == Utf16BE) return false;
+
+    qint64 zeros = 0;
+    qint64 controls = 0;
+    countUnusualBytes(data, length, &zeros, &controls);
+    if (zeros * 1024 >= length && zeros > 0) return true;      //more than about one zero per kilobyte
+    if (controls * 10 > length) return true;
+
+    if (format.encoding == Utf8) return false;
+    return invalidUtf8Count(data, length) * 10 > length && controls * 100 > length;
+}
+
+QByteArray TextEncoding::byteOrderMark(Encoding encoding) {
+/*  -returns the byte order mark of `encoding` (empty if it has none) */
+    switch (encoding) {
+        case Utf8:      return QByteArray("\xEF\xBB\xBF", 3);
+        case Utf16LE:   return QByteArray("\xFF\xFE", 2);
+        case Utf16BE:   return QByteArray("\xFE\xFF", 2);
+        default:        return QByteArray();
+    }
+}
+
+QTextCodec* TextEncoding::codecFor(Encoding encoding) {
+/*  -returns the codec used to convert text in `encoding` */
+    switch (encoding) {
+        case Utf16LE:   return QTextCodec::codecForName("UTF-16LE");
+        case Utf16BE:   return QTextCodec::codecForName("UTF-16BE");
+        case Latin1:    return QTextCodec::codecForName("ISO-8859-1");
+        default:        return QTextCodec::codecForName("UTF-8");
+    }
+}
+
+QByteArray TextEncoding::fromUtf8(const char* data, qint64 length, const Format& format, bool* lossless) {
+/*
+-returns the `length` bytes of UTF-8 text at `data` converted to `format` (including its byte order mark)
+-`lossless` (if given) is set to false if some characters can not be represented in the encoding
+*/
+    if (lossless != 0) *lossless = true;
+
+    QByteArray result;
+    if (format.hasBom) result = byteOrderMark(format.encoding);
+
+    if (format.encoding == Utf8) {
+        result.append(data, length);
+        return result;
+    }
+
+    //the text is converted in blocks so that the whole document is never held as UTF-16 at once
+    QTextCodec* codec = codecFor(format.encoding);
+    QTextDecoder decoder( QTextCodec::codecForName("UTF-8") );
+    QTextCodec::ConverterState state(QTextCodec::IgnoreHeader);
+    result.reserve( format.encoding == Latin1 ? length : length * 2 );
+
+    const qint64 blockSize = 1048576;
+    for (qint64 i = 0; i < length; i += blockSize) {
+        QString block = decoder.toUnicode(data + i, int( qMin(blockSize, length - i) ));
+        result.append( codec->fromUnicode(block.constData(), block.length(), &state) );
+    }
+
+    if (lossless != 0 && state.invalidChars > 0) *lossless = false;
+    return result;
+}
@@ -0,0 +1,92 @@
+/*
+Project: Lepton Editor
+File: textencoding.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the TextEncoding class.  It detects how the text
+    of a file is encoded (UTF-8, UTF-16 or Latin-1, with or without a byte order mark) and
+    converts text between that encoding and UTF-8, which is how documents are stored in the
+    editor.  It also tells files which are not text at all (binary files) apart.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEXTENCODING_H
+#define TEXTENCODING_H
+
+//include Qt classes
+#include <QByteArray>
+#include <QString>
+#include <QTextCodec>
+#include <QtGlobal>
+
+
+
+class TextEncoding {
+/* -A class with functions to detect the encoding of text and convert it to and from UTF-8. */
+
+    public:
+        enum Encoding {
+            Utf8,
+            Utf16LE,
+            Utf16BE,
+            Latin1
+        };
+
+        struct Format {
+                Encoding encoding;  //encoding of the text
+                bool hasBom;        //true if the text starts with a byte order mark
+
+                Format(Encoding _encoding = Utf8, bool _hasBom = false) : encoding(_encoding), hasBom(_hasBom) {}
+                bool isUtf8() const { return encoding == Utf8 && !hasBom; }
+        };
+
+        static Format detect(const uchar* data, qint64 length, bool complete = true);
+        /*
+            -returns the encoding of the `length` bytes at `data`
+            -if `complete` is false, the bytes are only the start of the text (a character may be cut at the end)
+        */
+
+        static bool isValidUtf8(const uchar* data, qint64 length);
+        /*  -returns true if the `length` bytes at `data` are valid UTF-8 (overlong forms and surrogates are rejected) */
+
+        static bool looksBinary(const uchar* data, qint64 length);
+        /*  -returns true if the `length` bytes at `data` (ex. the start of a file) look like binary data rather than text */
+
+        static QByteArray byteOrderMark(Encoding encoding);
+        /*  -returns the byte order mark of `encoding` (empty if it has none) */
+
+        static QTextCodec* codecFor(Encoding encoding);
+        /*  -returns the codec used to convert text in `encoding` */
+
+        static QByteArray fromUtf8(const char* data, qint64 length, const Format& format, bool* lossless = 0);
+        /*
+            -returns the `length` bytes of UTF-8 text at `data` converted to `format` (including its byte order mark)
+            -`lossless` (if given) is set to false if some characters can not be represented in the encoding
+        */
+};
+
+#endif // TEXTENCODING_H
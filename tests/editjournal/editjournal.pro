@@ -0,0 +1,33 @@
+include(../tests.pri)
+
+TARGET = tst_editjournal
+
+SOURCES += tst_editjournal.cpp \
+    ../../src/scintillaeditor.cpp \
+    ../../src/syntaxhighlightmanager.cpp \
+    ../../src/editjournal.cpp \
+    ../../src/fileloader.cpp \
+    ../../src/linediff.cpp \
+    ../../src/prefetchjob.cpp \
+    ../../src/savejob.cpp \
+    ../../src/savetransforms.cpp \
+    ../../src/textencoding.cpp \
+    ../../src/leptonlexer.cpp \
+    ../../src/grammarregistry.cpp \
+    ../../src/lexerprofiler.cpp \
+    ../../src/generalconfig.cpp
+
+HEADERS += ../../src/scintillaeditor.h \
+    ../../src/syntaxhighlightmanager.h \
+    ../../src/editjournal.h \
+    ../../src/fileloader.h \
+    ../../src/linediff.h \
+    ../../src/prefetchjob.h \
+    ../../src/savejob.h \
+    ../../src/savetransforms.h \
+    ../../src/textencoding.h \
+    ../../src/leptonlexer.h \
+    ../../src/grammarregistry.h \
+    ../../src/lexerprofiler.h \
+    ../../src/generalconfig.h \
+    ../../src/leptonconfig.h
@@ -0,0 +1,172 @@
+/*
+Project: Lepton Editor
+File: tst_editjournal.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the unit tests of the EditJournal class, as used by the editor.  They
+    check that replaying the journal of a document on top of the file it was last saved to
+    gives the document back, including when the save transforms changed the document.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//include Qt classes
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QDataStream>
+#include <QDateTime>
+#include <QByteArray>
+#include <QString>
+
+//include QScintilla classes
+#include <Qsci/qsciscintilla.h>
+
+//include other Lepton files used by the tests
+#include "scintillaeditor.h"
+#include "editjournal.h"
+#include "savetransforms.h"
+#include "leptonconfig.h"
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static QByteArray readFile(const QString& filePath) {
+/*  -returns the contents of the file at `filePath` (empty if it can not be read) */
+    QFile file(filePath);
+    if (! file.open(QIODevice::ReadOnly) ) return QByteArray();
+    return file.readAll();
+}
+
+static QByteArray journalRecords() {
+/*  -returns the changes recorded in the journal written by this process (empty if there is none) */
+    QDir journalsDir( QDir( LeptonConfig::mainSettings->getConfigDirPath("sessions") ).filePath("journals") );
+    QFileInfoList journals = journalsDir.entryInfoList(QStringList( QString("%1-*.journal").arg(QCoreApplication::applicationPid()) ), QDir::Files);
+    if ( journals.isEmpty() ) return QByteArray();
+
+    //the records follow a header describing the base of the journal (see `EditJournal::header()`)
+    QFile file( journals.first().absoluteFilePath() );
+    if (! file.open(QIODevice::ReadOnly) ) return QByteArray();
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    QString baseFilePath;
+    QDateTime baseModified;
+    qint64 baseSize = 0;
+    stream >> magic >> baseFilePath >> baseModified >> baseSize;
+    if (stream.status() != QDataStream::Ok || magic != 0x4C504A31) return QByteArray();
+    return file.readAll();
+}
+
+static QByteArray replayedText(const QByteArray& baseText) {
+/*  -returns the text given by replaying the journal written by this process on `baseText` (empty if it can not be replayed) */
+    QsciScintilla editor;
+    editor.setUtf8(true);
+    editor.setText( QString::fromUtf8(baseText) );
+    if (! EditJournal::replay(journalRecords(), &editor) ) return QByteArray();
+    return editor.text().toUtf8();
+}
+
+
+
+class TestEditJournal : public QObject {
+/* -Unit tests of the EditJournal class */
+
+    Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        /*  -makes the bundled config files available to the tests (journals are written in the sessions directory) */
+
+        void replayAfterSave_data();
+        void replayAfterSave();
+        /*
+            -checks that the journal of a document saved with the save transforms, replayed on the file
+             written, gives the document back (even if the transforms could not be applied to the document
+             because it was edited while it was saved)
+        */
+};
+
+void TestEditJournal::initTestCase() {
+/*  -makes the bundled config files available to the tests (journals are written in the sessions directory) */
+    QVERIFY( QDir::setCurrent(LEPTON_SOURCE_DIR) );
+    QVERIFY( ! LeptonConfig::mainSettings->getConfigDirPath("sessions").isEmpty() );
+}
+
+void TestEditJournal::replayAfterSave_data() {
+    QTest::addColumn<QByteArray>("textInsertedWhileSaving");
+    QTest::addColumn<QByteArray>("textInsertedAfterSave");
+
+    QTest::newRow("no change after the save") << QByteArray() << QByteArray();
+    QTest::newRow("changes after the save") << QByteArray() << QByteArray("inserted line  \n");
+    QTest::newRow("changes while saving") << QByteArray("inserted line  \n") << QByteArray();
+    QTest::newRow("changes while saving and after the save") << QByteArray("inserted line  \n") << QByteArray("another line \n");
+}
+
+void TestEditJournal::replayAfterSave() {
+    QFETCH(QByteArray, textInsertedWhileSaving);
+    QFETCH(QByteArray, textInsertedAfterSave);
+
+    QTemporaryDir dir;
+    QVERIFY( dir.isValid() );
+    QString filePath = QDir( dir.path() ).filePath("journaled.txt");
+    QFile file(filePath);
+    QVERIFY( file.open(QIODevice::WriteOnly) );
+    file.write("first line\nsecond line\n");
+    file.close();
+
+    ScintillaEditor editor;
+    editor.loadFile(filePath);
+    QTRY_VERIFY( ! editor.isLoading() );
+
+    //only the lines changed since the file was loaded are stripped, so lines with trailing spaces are added
+    editor.SendScintilla(QsciScintillaBase::SCI_INSERTTEXT, editor.length(), "third line   \nfourth line\t \n");
+    editor.saveInBackground(filePath, SaveTransforms::StripTrailingSpaces);
+
+    //the save job can only send its edits back once control returns to the event loop, so they do not fit the document anymore
+    if ( ! textInsertedWhileSaving.isEmpty() ) editor.SendScintilla(QsciScintillaBase::SCI_INSERTTEXT, 0, textInsertedWhileSaving.constData());
+    QTRY_VERIFY( ! editor.isSaving() );
+
+    QByteArray savedText = readFile(filePath);
+    QCOMPARE( savedText, QByteArray("first line\nsecond line\nthird line\nfourth line\n") );
+    if ( textInsertedWhileSaving.isEmpty() ) QCOMPARE( editor.text().toUtf8(), savedText );
+    else QCOMPARE( editor.text().toUtf8(), textInsertedWhileSaving + "first line\nsecond line\nthird line   \nfourth line\t \n" );
+
+    if ( ! textInsertedAfterSave.isEmpty() ) editor.SendScintilla(QsciScintillaBase::SCI_INSERTTEXT, 0, textInsertedAfterSave.constData());
+    QByteArray documentText = editor.text().toUtf8();
+
+    //the journal is synced after a short delay, so the changes made after the save may take a moment to be replayable
+    QTRY_COMPARE( replayedText(savedText), documentText );
+}
+
+
+
+QTEST_MAIN(TestEditJournal)
+#include "tst_editjournal.moc"
@@ -0,0 +1,17 @@
+include(../tests.pri)
+
+TARGET = tst_leptonlexer
+
+SOURCES += tst_leptonlexer.cpp \
+    lexerverifier.cpp \
+    ../../src/leptonlexer.cpp \
+    ../../src/grammarregistry.cpp \
+    ../../src/lexerprofiler.cpp \
+    ../../src/generalconfig.cpp
+
+HEADERS += lexerverifier.h \
+    ../../src/leptonlexer.h \
+    ../../src/grammarregistry.h \
+    ../../src/lexerprofiler.h \
+    ../../src/generalconfig.h \
+    ../../src/leptonconfig.h
@@ -0,0 +1,422 @@
+/*
+Project: Lepton Editor
+File: lexerverifier.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the implementation for the LexerVerifier class.  It checks that the
+    optimizations made to the lexer do not change how text is highlighted, by comparing
+    incremental styling with a full restyle on random documents and edits.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+//include this file's header
+#include "lexerverifier.h"
+
+//include Qt classes
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDomDocument>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QSharedPointer>
+
+//include other Lepton files used for this class implementation
+#include "leptonconfig.h"
+#include "grammarregistry.h"
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static const int documentsPerLanguage = 20;     //number of random documents verified for each language
+static const int tokensPerDocument = 300;       //number of tokens in each random document
+static const int editsPerDocument = 20;         //number of random edits made to each document
+static const int maxMinimizeAttempts = 2000;    //maximum number of test cases tried while minimizing a divergence
+
+static void addLiteralFragments(const QString& pattern, QSet<QString>& fragments) {
+/*  -adds the runs of literal characters in the regular expression `pattern` to `fragments` */
+    static const QString metaCharacters("()[]{}|?+*.^$");
+    QString fragment;
+
+    for (int i = 0, length = pattern.length(); i < length; i++) {
+        QChar c = pattern.at(i);
+        if (c == '\\' && i + 1 < length) {
+            QChar next = pattern.at(++i);
+            if ( next.isLetterOrNumber() ) {    //character classes and anchors (\b, \d, \s, etc.) end the fragment
+                if ( ! fragment.isEmpty() ) fragments.insert(fragment);
+                fragment.clear();
+                if (next == 'n') fragments.insert("\n");
+            }
+            else fragment.append(next);
+        }
+        else if ( metaCharacters.contains(c) ) {
+            if ( ! fragment.isEmpty() ) fragments.insert(fragment);
+            fragment.clear();
+        }
+        else fragment.append(c);
+    }
+    if ( ! fragment.isEmpty() ) fragments.insert(fragment);
+}
+
+static void addVocabularyOf(const TokenRule* rule, QSet<QString>& fragments, QSet<const TokenRule*>& visitedLanguages) {
+/*  -adds the literal text of every rule under `rule` (including the rules of the languages it includes) to `fragments` */
+    for (int i = 0, c = rule->subRules.count(); i < c; i++) {
+        const TokenRule& subRule = rule->subRules.at(i);
+        addLiteralFragments(subRule.rule.pattern(), fragments);
+        addLiteralFragments(subRule.closeRule.pattern(), fragments);
+        addVocabularyOf(&subRule, fragments, visitedLanguages);
+    }
+
+    if ( ! rule->include.isNull() && ! visitedLanguages.contains( rule->include.data() ) ) {
+        visitedLanguages.insert( rule->include.data() );
+        addVocabularyOf(rule->include.data(), fragments, visitedLanguages);
+    }
+}
+
+static int characterBoundary(QsciScintilla& editor, int position) {
+/*  -returns `position`, moved forward to the start of the next character if it is inside a (multi-byte) character */
+    if (position <= 0) return 0;
+    int previous = editor.SendScintilla(QsciScintillaBase::SCI_POSITIONBEFORE, position);
+    return editor.SendScintilla(QsciScintillaBase::SCI_POSITIONAFTER, previous);
+}
+
+static void styleDocument(QsciScintilla& editor) {
+/*  -styles the whole document, letting the lexer style long lines in several windows (as it does while editing) */
+    editor.SendScintilla(QsciScintillaBase::SCI_COLOURISE, 0, -1);
+
+    long endStyled = editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+    for (int i = 0; i < 100000 && endStyled < editor.length(); i++) {
+        QCoreApplication::processEvents();
+        long newEndStyled = editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+        if (newEndStyled == endStyled) editor.SendScintilla(QsciScintillaBase::SCI_COLOURISE, 0, -1);
+        endStyled = editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED);
+    }
+}
+
+static QByteArray stylesOf(QsciScintilla& editor) {
+/*  -returns the style of every byte in the document of `editor` */
+    const int length = editor.length();
+    QByteArray styles(length, '\0');
+    for (int i = 0; i < length; i++) styles[i] = char( editor.SendScintilla(QsciScintillaBase::SCI_GETSTYLEAT, i) );
+    return styles;
+}
+
+static int firstDifference(const QByteArray& a, const QByteArray& b) {
+/*  -returns the first position at which `a` and `b` differ, or -1 if they are the same */
+    const int length = qMin(a.length(), b.length());
+    for (int i = 0; i < length; i++) {
+        if (a.at(i) != b.at(i)) return i;
+    }
+    return a.length() == b.length() ? -1 : length;
+}
+
+static QString escaped(const QString& text) {
+/*  -returns `text` as a quoted string, with special characters escaped */
+    QString result = text;
+    result.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n").replace("\r", "\\r").replace("\t", "\\t");
+    return "\"" + result + "\"";
+}
+
+
+
+//~public methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LexerVerifier::LexerVerifier(const QString& _corpusDirPath, unsigned int seed) : corpusDirPath(_corpusDirPath), random(seed) {
+/*  -Class constructor (`_corpusDirPath` is a directory of sample files to verify in addition to generated documents) */
+    timing = true;
+    referenceTime = 0;
+    optimizedTime = 0;
+}
+
+int LexerVerifier::run(QTextStream& out) {
+/*  -runs all the checks, writes a report to `out` and returns the number of problems found */
+    QDir languagesDir( LeptonConfig::mainSettings->getLangsDirPath() );
+    QFileInfoList languageFiles = languagesDir.entryInfoList(QStringList("*.xml"), QDir::Files | QDir::Readable, QDir::Name);
+
+    QFileInfoList sampleFiles;
+    if ( ! corpusDirPath.isEmpty() ) sampleFiles = QDir(corpusDirPath).entryInfoList(QDir::Files | QDir::Readable, QDir::Name);
+
+    int problems = 0;
+
+    foreach (const QFileInfo& languageFile, languageFiles) {
+        out << languageFile.fileName() << "\n";
+        out.flush();
+
+        //use the files of the corpus which match the file mask of the language as samples
+        QStringList samples;
+        QFile file( languageFile.absoluteFilePath() );
+        QDomDocument languageDocument("languageData");
+        if ( file.open(QIODevice::ReadOnly) && languageDocument.setContent(&file) ) {
+            QRegularExpression filemask( languageDocument.documentElement().attribute("filemask") );
+            foreach (const QFileInfo& sampleFile, sampleFiles) {
+                if ( filemask.pattern().isEmpty() || ! filemask.match( sampleFile.fileName() ).hasMatch() ) continue;
+                QFile sample( sampleFile.absoluteFilePath() );
+                if ( sample.open(QIODevice::ReadOnly) ) samples.append( QString::fromUtf8( sample.readAll() ) );
+            }
+        }
+        file.close();
+
+        problems += verifyStyles(languageFile.absoluteFilePath(), samples, out);
+    }
+
+    out << "\n" << problems << " problem(s) found\n";
+    out << QString("full restyle: %1 ms, incremental styling: %2 ms").arg(referenceTime / 1000000.0).arg(optimizedTime / 1000000.0);
+    if (optimizedTime > 0) out << QString(" (%1x faster)").arg(double(referenceTime) / optimizedTime, 0, 'f', 2);
+    out << "\n";
+    out.flush();
+
+    return problems;
+}
+
+
+
+//~private methodes~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int LexerVerifier::verifyStyles(const QString& languageFile, const QStringList& samples, QTextStream& out) {
+/*  -checks that styling generated documents (and `samples`) incrementally gives the same styles as a full restyle */
+    QSharedPointer<const TokenRule> root = GrammarRegistry::getRegistry()->language(languageFile);
+    if ( root.isNull() ) return 0;
+
+    QStringList vocabulary = vocabularyOf( root.data() );
+
+    QList<TestCase> testCases;
+    foreach (const QString& sample, samples) {
+        TestCase testCase;
+        testCase.languageFile = languageFile;
+        testCase.text = sample;
+        testCase.edits = generateEdits(vocabulary, sample.length(), editsPerDocument);
+        testCases.append(testCase);
+    }
+    for (int i = 0; i < documentsPerLanguage; i++) {
+        TestCase testCase;
+        testCase.languageFile = languageFile;
+        testCase.text = generateText(vocabulary, tokensPerDocument);
+        testCase.edits = generateEdits(vocabulary, testCase.text.length(), editsPerDocument);
+        testCases.append(testCase);
+    }
+
+    //also verify a line long enough to be styled in windows
+    QStringList lineVocabulary = vocabulary.filter(QRegularExpression("^[^\\n\\r]+$"));
+    int longLineThreshold = LeptonConfig::mainSettings->getValueOrDefault(10000, "large_files", "long_line_threshold").toInt();
+    if (longLineThreshold > 0 && ! lineVocabulary.isEmpty() ) {
+        TestCase testCase;
+        testCase.languageFile = languageFile;
+        while ( testCase.text.length() < longLineThreshold * 3 / 2 ) testCase.text += generateText(lineVocabulary, tokensPerDocument);
+        testCase.edits = generateEdits(lineVocabulary, testCase.text.length(), editsPerDocument / 4);
+        testCases.append(testCase);
+    }
+
+    int problems = 0;
+    foreach (const TestCase& testCase, testCases) {
+        if ( findDivergence(testCase).edit < 0 ) continue;
+
+        problems++;
+        TestCase reproducer = minimize(testCase);
+        report(reproducer, findDivergence(reproducer), out);
+    }
+
+    out << "  styles: " << (problems == 0 ? QString("ok") : QString("%1 of %2 documents diverged").arg(problems).arg(testCases.count())) << "\n";
+    out.flush();
+    return problems;
+}
+
+LexerVerifier::Divergence LexerVerifier::findDivergence(const TestCase& testCase) {
+/*  -edits the document of `testCase` and returns where its styles first diverge from a full restyle */
+    QsciScintilla editor;
+    editor.setUtf8(true);
+    LeptonLexer* lexer = new LeptonLexer(&editor);
+    lexer->loadLanguage(testCase.languageFile);
+    editor.setLexer(lexer);
+    editor.setText(testCase.text);
+
+    QElapsedTimer timer;
+    Divergence divergence;
+    divergence.edit = -1;
+
+    for (int i = 0, count = testCase.edits.count(); i <= count; i++) {
+        if (i > 0) {
+            const Edit& edit = testCase.edits.at(i - 1);
+            int position = characterBoundary(editor, qMin(edit.position, editor.length()));
+            int removedEnd = characterBoundary(editor, qMin(position + edit.removedLength, editor.length()));
+            QByteArray insertedText = edit.insertedText.toUtf8();
+            editor.SendScintilla(QsciScintillaBase::SCI_DELETERANGE, position, removedEnd - position);
+            editor.SendScintilla(QsciScintillaBase::SCI_INSERTTEXT, position, insertedText.constData());
+        }
+
+        timer.start();
+        styleDocument(editor);
+        if (timing) optimizedTime += timer.nsecsElapsed();
+
+        QString text = editor.text();
+        timer.start();
+        QByteArray reference = referenceStyles(testCase.languageFile, text);
+        if (timing) referenceTime += timer.nsecsElapsed();
+
+        QByteArray optimized = stylesOf(editor);
+        int position = firstDifference(reference, optimized);
+        if (position >= 0) {
+            divergence.edit = i;
+            divergence.position = position;
+            divergence.referenceStyle = position < reference.length() ? int( uchar( reference.at(position) ) ) : -1;
+            divergence.optimizedStyle = position < optimized.length() ? int( uchar( optimized.at(position) ) ) : -1;
+            divergence.text = text;
+            break;
+        }
+    }
+
+    return divergence;
+}
+
+LexerVerifier::TestCase LexerVerifier::minimize(TestCase testCase) {
+/*  -returns the smallest test case (found greedily) whose styles still diverge */
+
+    /*########################################################################################
+    ### A test case is reduced one step at a time, keeping a step only if the styles still ##
+    ### diverge: first the edits made after the divergence are dropped, then every edit is  ##
+    ### removed in turn and, finally, chunks of the initial text are removed, starting with ##
+    ### halves of the text and ending with single characters.                               ##
+    ########################################################################################*/
+
+    timing = false;     //minimizing should not be counted in the styling times
+
+    Divergence divergence = findDivergence(testCase);
+    if (divergence.edit < 0) {
+        timing = true;
+        return testCase;
+    }
+    testCase.edits = testCase.edits.mid(0, divergence.edit);
+
+    int attempts = 0;
+    for (int i = testCase.edits.count() - 1; i >= 0 && attempts < maxMinimizeAttempts; i--, attempts++) {
+        TestCase candidate = testCase;
+        candidate.edits.removeAt(i);
+        if ( findDivergence(candidate).edit >= 0 ) testCase = candidate;
+    }
+
+    for (int chunk = testCase.text.length() / 2; chunk > 0 && attempts < maxMinimizeAttempts; chunk /= 2) {
+        for (int start = 0; start < testCase.text.length() && attempts < maxMinimizeAttempts; attempts++) {
+            TestCase candidate = testCase;
+            candidate.text.remove(start, chunk);
+            if ( findDivergence(candidate).edit >= 0 ) testCase = candidate;
+            else start += chunk;
+        }
+    }
+
+    timing = true;
+    return testCase;
+}
+
+void LexerVerifier::report(const TestCase& testCase, const Divergence& divergence, QTextStream& out) {
+/*  -writes a test case, and where its styles diverge, to `out` */
+    out << "  divergence found, reproduced by:\n";
+    out << "    text: " << escaped(testCase.text) << "\n";
+    for (int i = 0, c = testCase.edits.count(); i < c; i++) {
+        const Edit& edit = testCase.edits.at(i);
+        out << QString("    edit %1: at %2, remove %3, insert ").arg(i + 1).arg(edit.position).arg(edit.removedLength) << escaped(edit.insertedText) << "\n";
+    }
+
+    if (divergence.edit < 0) {
+        out << "    (the reduced test case no longer diverges)\n";
+        return;
+    }
+
+    QByteArray text = divergence.text.toUtf8();
+    QString context = QString::fromUtf8( text.mid(qMax(0, divergence.position - 20), 40) );
+    out << QString("    at position %1: style %2 instead of %3, near ").arg(divergence.position).arg(divergence.optimizedStyle).arg(divergence.referenceStyle) << escaped(context) << "\n";
+    out.flush();
+}
+
+QByteArray LexerVerifier::referenceStyles(const QString& languageFile, const QString& text) {
+/*  -returns the styles of `text` when it is styled from scratch in a single pass */
+    QsciScintilla editor;
+    editor.setUtf8(true);
+    LeptonLexer* lexer = new LeptonLexer(&editor);
+    lexer->setLongLineThreshold(0);     //style long lines in one pass, like any other line
+    lexer->loadLanguage(languageFile);
+    editor.setLexer(lexer);
+    editor.setText(text);
+    editor.SendScintilla(QsciScintillaBase::SCI_COLOURISE, 0, -1);
+    return stylesOf(editor);
+}
+
+QStringList LexerVerifier::vocabularyOf(const TokenRule* root) {
+/*  -returns the literal text found in the rules of a language (keywords, delimiters, etc.) */
+    QSet<QString> fragments;
+    QSet<const TokenRule*> visitedLanguages;
+    addVocabularyOf(root, fragments, visitedLanguages);
+
+    //text which is not part of any rule is needed too
+    fragments << " " << "    " << "\n" << "\t" << "x" << "name_1" << "42" << "0x1F" << "\\" << "\"" << "'";
+
+    //as well as characters encoded with two, three and four bytes in UTF-8
+    fragments << QString::fromUtf8("\xC3\xA9") << QString::fromUtf8("na\xC3\xAFve") << QString::fromUtf8("\xE2\x82\xAC") << QString::fromUtf8("\xE2\x98\x85") << QString::fromUtf8("\xF0\x9F\x98\x80");
+
+    //the fragments are sorted so that a given seed always generates the same documents
+    QStringList vocabulary = fragments.toList();
+    vocabulary.sort();
+    return vocabulary;
+}
+
+QString LexerVerifier::generateText(const QStringList& vocabulary, int tokenCount) {
+/*  -returns random text made of `tokenCount` tokens taken from `vocabulary` */
+    QString text;
+    for (int i = 0; i < tokenCount; i++) {
+        text += vocabulary.at( randomInt(vocabulary.count()) );
+        if ( randomInt(2) == 0 ) text += ' ';
+    }
+    return text;
+}
+
+QList<LexerVerifier::Edit> LexerVerifier::generateEdits(const QStringList& vocabulary, int textLength, int editCount) {
+/*  -returns `editCount` random edits of a document about `textLength` characters long */
+    QList<Edit> edits;
+
+    for (int i = 0; i < editCount; i++) {
+        Edit edit;
+        edit.position = randomInt(textLength + 1);
+
+        int kind = randomInt(3);    //0: insertion, 1: deletion, 2: replacement
+        edit.removedLength = kind == 0 ? 0 : 1 + randomInt(16);
+        if (kind != 1) edit.insertedText = generateText(vocabulary, 1 + randomInt(4));
+
+        textLength = qMax(0, textLength - edit.removedLength) + edit.insertedText.length();
+        edits.append(edit);
+    }
+
+    return edits;
+}
+
+int LexerVerifier::randomInt(int bound) {
+/*  -returns a random integer between 0 and `bound` - 1 */
+    if (bound <= 1) return 0;
+    return std::uniform_int_distribution<int>(0, bound - 1)(random);
+}
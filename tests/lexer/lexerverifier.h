@@ -0,0 +1,131 @@
+/*
+Project: Lepton Editor
+File: lexerverifier.h
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the definition for the LexerVerifier class.  It checks that the
+    optimizations made to the lexer do not change how text is highlighted: styling a
+    document incrementally, while it is being edited (with the saved rule stacks, long
+    line windows, etc.), must give the same styles as styling the final text from scratch,
+    in a single pass.
+
+    Documents are generated randomly from the literal text found in the rules of each
+    language (and, optionally, read from a corpus directory) and then edited randomly.
+    When styles diverge, the document and edits are reduced to a small reproducer.
+
+    The verifier is run by the lexer tests (tst_leptonlexer), with the sample files of
+    tests/lexer/samples as its corpus.  Documents are styled in UTF-8 editors, like the
+    documents opened in Lepton, and the vocabulary includes non-ASCII characters so that
+    styles are also verified at multi-byte characters.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LEXERVERIFIER_H
+#define LEXERVERIFIER_H
+
+//include Qt classes
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <QTextStream>
+#include <QtGlobal>
+
+//include other Lepton files needed by this class
+#include "leptonlexer.h"
+
+//include other standard library classes
+#include <random>
+
+
+
+class LexerVerifier {
+/* -A class that checks that the optimized lexer styles text the same way as a straightforward, full restyle. */
+
+    public:
+        explicit LexerVerifier(const QString& _corpusDirPath = QString(), unsigned int seed = 1);
+        /*  -Class constructor (`_corpusDirPath` is a directory of sample files to verify in addition to generated documents) */
+
+        int run(QTextStream& out);
+        /*  -runs all the checks, writes a report to `out` and returns the number of problems found */
+
+    private:
+        struct Edit {
+                int position;           //position at which the edit is made (clamped to the length of the document)
+                int removedLength;      //number of characters removed at `position`
+                QString insertedText;   //text inserted at `position`, after the characters are removed
+        };
+
+        struct TestCase {
+                QString languageFile;   //path to the language file used to style the document
+                QString text;           //initial text of the document
+                QList<Edit> edits;      //edits made to the document, in order
+        };
+
+        struct Divergence {
+                int edit;               //number of edits made when styles diverged (-1 if they did not diverge)
+                int position;           //first position at which styles differ
+                int referenceStyle;     //style given to `position` by a full restyle
+                int optimizedStyle;     //style given to `position` by incremental styling
+                QString text;           //text of the document when styles diverged
+        };
+
+        QString corpusDirPath;  //directory of sample files to verify (empty if none)
+        std::mt19937 random;    //random number generator used to generate documents and edits (seeded for reproducible runs)
+        bool timing;            //true if the time taken to style documents should be recorded
+        qint64 referenceTime;   //time spent styling documents from scratch (in nanoseconds)
+        qint64 optimizedTime;   //time spent styling documents incrementally (in nanoseconds)
+
+        int verifyStyles(const QString& languageFile, const QStringList& samples, QTextStream& out);
+        /*  -checks that styling generated documents (and `samples`) incrementally gives the same styles as a full restyle */
+
+        Divergence findDivergence(const TestCase& testCase);
+        /*  -edits the document of `testCase` and returns where its styles first diverge from a full restyle */
+
+        TestCase minimize(TestCase testCase);
+        /*  -returns the smallest test case (found greedily) whose styles still diverge */
+
+        void report(const TestCase& testCase, const Divergence& divergence, QTextStream& out);
+        /*  -writes a test case, and where its styles diverge, to `out` */
+
+        QByteArray referenceStyles(const QString& languageFile, const QString& text);
+        /*  -returns the styles of `text` when it is styled from scratch in a single pass */
+
+        QStringList vocabularyOf(const TokenRule* root);
+        /*  -returns the literal text found in the rules of a language (keywords, delimiters, etc.) */
+
+        QString generateText(const QStringList& vocabulary, int tokenCount);
+        /*  -returns random text made of `tokenCount` tokens taken from `vocabulary` */
+
+        QList<Edit> generateEdits(const QStringList& vocabulary, int textLength, int editCount);
+        /*  -returns `editCount` random edits of a document about `textLength` characters long */
+
+        int randomInt(int bound);
+        /*  -returns a random integer between 0 and `bound` - 1 */
+};
+
+#endif // LEXERVERIFIER_H
@@ -0,0 +1,12 @@
+#include <stdio.h>
+
+/* Grüße aus Köln ★
+ * a block comment over several lines
+ */
+static const char* greeting = "Hallo, Grüße! \"ünï\" 😀";
+
+int main(void) {
+    char c = 'x';   // déjà vu ☃
+    int año = 42;
+    return año > 0x1F ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+// Ωmega — a C++ sample
+#define NAME "naïve"
+namespace tëst {
+    class Größe {
+        public:
+            virtual double value() const { return 3.14; }   /* π ≈ 3.14 */
+    };
+}
+auto s = "emoji: 🎉 and 漢字";
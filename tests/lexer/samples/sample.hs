@@ -0,0 +1,5 @@
+module Main where
+-- Grüße, λ calculus
+data Größe = Klein | Groß deriving Show
+main :: IO ()
+main = putStrLn "héllo → 🌍" {- ✓ done -}
@@ -0,0 +1,6 @@
+/* café ☕ */
+function grüß(name) {
+    var msg = 'Grüß dich, ' + name + '! 👋';
+    return msg; // → done
+}
+const pi = 3.14, τ = "2π";
@@ -0,0 +1,9 @@
+# -*- coding: utf-8 -*-
+"""Docstring with ümlauts
+and a second line — 🐍"""
+def naïve_sum(values):
+    total = 0
+    for v in values:
+        total += v  # Σ of the values
+    return total
+print('€ %d' % naïve_sum([1, 2, 3]), "日本語\"")
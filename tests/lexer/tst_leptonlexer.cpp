@@ -0,0 +1,329 @@
+/*
+Project: Lepton Editor
+File: tst_leptonlexer.cpp
+Author: Leonardo Banderali
+Created: October 18, 2026
+Last Modified: October 18, 2026
+
+Description:
+    Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+    flexible and extensible code editor which developers can easily customize to their
+    liking.
+
+    This file contains the unit tests of the LeptonLexer class.  They check that text is
+    styled at the right positions when the editor is in UTF-8 mode, where Scintilla positions
+    are byte offsets but the token rules are matched against UTF-16 text.
+
+    The sample files of tests/lexer/samples are styled and compared with the expected styles
+    stored next to them (in `<sample>.styles`, one line of styles per line of the sample and
+    one character per style, using the digits 0-9 then the letters a-v).  They are also used
+    by the LexerVerifier, which checks that incremental styling gives the same styles as a
+    full restyle.
+
+Copyright (C) 2026 Leonardo Banderali
+
+Usage Agreement:
+    This file is part of Lepton Editor
+
+    Lepton Editor is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    Lepton Editor is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//include Qt classes
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDomDocument>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QList>
+#include <QVector>
+#include <QCryptographicHash>
+
+//include QScintilla classes
+#include <Qsci/qsciscintilla.h>
+
+//include other Lepton files used by the tests
+#include "leptonlexer.h"
+#include "leptonconfig.h"
+#include "lexerverifier.h"
+#include "builtinlanguages.h"
+
+
+
+//~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static const QString samplesDirPath(LEPTON_SOURCE_DIR "/tests/lexer/samples");     //directory of the sample files and their stored styles
+
+static void styleText(QsciScintilla& editor, const QString& languageFile, const QString& text, int longLineThreshold) {
+/*
+-styles `text` in `editor` (in UTF-8 mode) with the language defined in `languageFile`
+-lines longer than `longLineThreshold` are styled in windows (0 disables windowed styling)
+*/
+    editor.setUtf8(true);
+    LeptonLexer* lexer = new LeptonLexer(&editor);
+    QVERIFY( lexer->loadLanguage( LeptonConfig::mainSettings->getLangFilePath(languageFile) ) );
+    lexer->setLongLineThreshold(longLineThreshold);
+    editor.setLexer(lexer);
+    editor.setText(text);
+
+    //long lines are styled one window at a time, the next window being styled from the event loop
+    editor.SendScintilla(QsciScintillaBase::SCI_COLOURISE, 0, -1);
+    for (int i = 0; i < 100000 && editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED) < editor.length(); i++) {
+        QCoreApplication::processEvents();
+        editor.SendScintilla(QsciScintillaBase::SCI_COLOURISE, editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED), -1);
+    }
+    QCOMPARE( int( editor.SendScintilla(QsciScintillaBase::SCI_GETENDSTYLED) ), editor.length() );
+}
+
+static QList<int> characterStyles(QsciScintilla& editor) {
+/*
+-returns the style of every character (not byte) in the document of `editor`
+-fails the current test if the bytes of a character do not all have the same style
+*/
+    QList<int> styles;
+    for (int position = 0, length = editor.length(); position < length; ) {
+        int next = editor.SendScintilla(QsciScintillaBase::SCI_POSITIONAFTER, position);
+        int style = editor.SendScintilla(QsciScintillaBase::SCI_GETSTYLEAT, position);
+        for (int i = position + 1; i < next; i++) {
+            if ( editor.SendScintilla(QsciScintillaBase::SCI_GETSTYLEAT, i) != style ) {
+                QTest::qFail( qPrintable( QString("the bytes of the character at %1 have different styles").arg(position) ), __FILE__, __LINE__ );
+                return styles;
+            }
+        }
+        styles.append(style);
+        position = next;
+    }
+    return styles;
+}
+
+static QString encodedStyles(const QString& text, const QList<int>& styles) {
+/*  -returns `styles` (the style of every character of `text`) in the format of the stored styles of the samples */
+    static const QString styleDigits("0123456789abcdefghijklmnopqrstuv");
+    QString encoded;
+    QVector<uint> characters = text.toUcs4();
+    for (int i = 0, count = qMin(characters.count(), styles.count()); i < count; i++) {
+        encoded.append( styles.at(i) < styleDigits.length() ? styleDigits.at( styles.at(i) ) : QChar('?') );
+        if (characters.at(i) == '\n') encoded.append('\n');
+    }
+    return encoded;
+}
+
+static QString languageFileFor(const QString& fileName) {
+/*  -returns the name of the language file whose file mask matches `fileName` (empty if there is none) */
+    QDir languagesDir( LeptonConfig::mainSettings->getLangsDirPath() );
+    foreach (const QFileInfo& languageFile, languagesDir.entryInfoList(QStringList("*.xml"), QDir::Files | QDir::Readable, QDir::Name)) {
+        QFile file( languageFile.absoluteFilePath() );
+        QDomDocument languageDocument("languageData");
+        if ( ! file.open(QIODevice::ReadOnly) || ! languageDocument.setContent(&file) ) continue;
+
+        QRegularExpression filemask( languageDocument.documentElement().attribute("filemask") );
+        if ( ! filemask.pattern().isEmpty() && filemask.match(fileName).hasMatch() ) return languageFile.fileName();
+    }
+    return QString();
+}
+
+static QString asciiVersionOf(const QString& text) {
+/*  -returns `text` with every character outside of ASCII replaced by 'x' */
+    QString ascii;
+    for (int i = 0, length = text.length(); i < length; i++) {
+        if ( text.at(i).isLowSurrogate() ) continue;    //the high surrogate was already replaced
+        ascii.append( text.at(i).unicode() < 0x80 ? text.at(i) : QChar('x') );
+    }
+    return ascii;
+}
+
+
+
+class TestLeptonLexer : public QObject {
+/* -Unit tests of the LeptonLexer class */
+
+    Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        /*  -makes the bundled config files (languages and styles) available to the tests */
+
+        void nonAsciiText_data();
+        void nonAsciiText();
+        /*
+            -checks that text containing multi-byte characters is styled like the same text with
+             only ASCII characters, character for character
+        */
+
+        void storedStyles_data();
+        void storedStyles();
+        /*  -checks that the sample files are styled as recorded in their stored styles */
+
+        void incrementalStyling();
+        /*  -checks (with the LexerVerifier) that styling documents while they are edited gives the same styles as a full restyle */
+
+        void nativeMatchers_data();
+        void nativeMatchers();
+        /*
+            -checks that the native matchers generated for a bundled language file give the same results
+             as the regular expressions they were generated from, on every piece of the sample files
+        */
+};
+
+void TestLeptonLexer::initTestCase() {
+/*  -makes the bundled config files (languages and styles) available to the tests */
+    QVERIFY( QDir::setCurrent(LEPTON_SOURCE_DIR) );
+    QVERIFY( ! LeptonConfig::mainSettings->getLangsDirPath().isEmpty() );
+}
+
+void TestLeptonLexer::nonAsciiText_data() {
+    QTest::addColumn<QString>("languageFile");
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("longLineThreshold");
+
+    //non-ASCII characters are only used in strings and comments, where the rules match any character
+    QTest::newRow("line comment") << "c.xml"
+        << QString::fromUtf8("int a; // d\xC3\xA9j\xC3\xA0 vu\nint b = 1;\n") << 0;
+    QTest::newRow("string literal") << "c.xml"
+        << QString::fromUtf8("char* s = \"na\xC3\xAFve \xE2\x98\x83 \xF0\x9F\x98\x80\"; int x = 42;\n") << 0;
+    QTest::newRow("block comment over several lines") << "c.xml"
+        << QString::fromUtf8("/* \xE2\x98\x85 \xC3\xBCn\xC3\xAF\n \xE2\x98\x85 c\xC3\xB6\x64\xC3\xA9 */ int z = 42;\nreturn z;\n") << 0;
+    QTest::newRow("python string and comment") << "python.xml"
+        << QString::fromUtf8("s = '\xE2\x82\xAC\xF0\x9F\x98\x80' # \xC2\xB5s\nif s: pass\n") << 0;
+
+    QString longLine;
+    for (int i = 0; i < 200; i++) longLine += QString::fromUtf8("int a = 1; char* s = \"\xC3\xBC\xE2\x82\xAC\xF0\x9F\x98\x80\"; /* \xE2\x98\x85 */ ");
+    QTest::newRow("long line styled in windows") << "c.xml" << longLine + "\nint b = 2;\n" << 64;
+}
+
+void TestLeptonLexer::nonAsciiText() {
+    QFETCH(QString, languageFile);
+    QFETCH(QString, text);
+    QFETCH(int, longLineThreshold);
+
+    QsciScintilla editor;
+    styleText(editor, languageFile, text, longLineThreshold);
+    QsciScintilla asciiEditor;
+    styleText(asciiEditor, languageFile, asciiVersionOf(text), longLineThreshold);
+
+    QList<int> styles = characterStyles(editor);
+    QList<int> asciiStyles = characterStyles(asciiEditor);
+    QCOMPARE(styles.count(), asciiStyles.count());
+    for (int i = 0, count = styles.count(); i < count; i++) {
+        if (styles.at(i) != asciiStyles.at(i))
+            QFAIL( qPrintable( QString("character %1 has style %2 instead of %3").arg(i).arg(styles.at(i)).arg(asciiStyles.at(i)) ) );
+    }
+}
+
+void TestLeptonLexer::storedStyles_data() {
+    QTest::addColumn<QString>("sampleFile");
+    QTest::addColumn<QString>("languageFile");
+
+    QDir samplesDir(samplesDirPath);
+    foreach (const QFileInfo& stylesFile, samplesDir.entryInfoList(QStringList("*.styles"), QDir::Files, QDir::Name)) {
+        QString sampleFile = stylesFile.completeBaseName();
+        QTest::newRow( qPrintable(sampleFile) ) << samplesDir.filePath(sampleFile) << languageFileFor(sampleFile);
+    }
+}
+
+void TestLeptonLexer::storedStyles() {
+    QFETCH(QString, sampleFile);
+    QFETCH(QString, languageFile);
+    QVERIFY2( ! languageFile.isEmpty(), "no language file matches the sample" );
+
+    QFile sample(sampleFile);
+    QVERIFY( sample.open(QIODevice::ReadOnly) );
+    QString text = QString::fromUtf8( sample.readAll() );
+    QFile stylesFile(sampleFile + ".styles");
+    QVERIFY( stylesFile.open(QIODevice::ReadOnly) );
+    QStringList expectedLines = QString::fromLatin1( stylesFile.readAll() ).split('\n');
+
+    QsciScintilla editor;
+    styleText(editor, languageFile, text, 0);
+    QStringList lines = encodedStyles( text, characterStyles(editor) ).split('\n');
+
+    //compare the styles line by line, so that a failure points to the line styled differently
+    QStringList textLines = text.split('\n');
+    for (int i = 0, count = qMin( lines.count(), expectedLines.count() ); i < count; i++) {
+        if (lines.at(i) != expectedLines.at(i)) {
+            QFAIL( qPrintable( QString("line %1 (%2) is styled %3 instead of %4").arg(i + 1)
+                .arg( i < textLines.count() ? textLines.at(i) : QString() ).arg( lines.at(i) ).arg( expectedLines.at(i) ) ) );
+        }
+    }
+    QCOMPARE( lines.count(), expectedLines.count() );
+}
+
+void TestLeptonLexer::incrementalStyling() {
+    QString report;
+    QTextStream out(&report);
+    LexerVerifier verifier(samplesDirPath);
+    int problems = verifier.run(out);
+    QVERIFY2( problems == 0, qPrintable(report) );
+}
+
+
+void TestLeptonLexer::nativeMatchers_data() {
+    QTest::addColumn<QString>("languageFile");
+
+    QDir languagesDir( LeptonConfig::mainSettings->getLangsDirPath() );
+    foreach (const QFileInfo& languageFile, languagesDir.entryInfoList(QStringList("*.xml"), QDir::Files, QDir::Name)) {
+        QTest::newRow( qPrintable(languageFile.fileName()) ) << languageFile.filePath();
+    }
+}
+
+void TestLeptonLexer::nativeMatchers() {
+    QFETCH(QString, languageFile);
+
+    QFile file(languageFile);
+    QVERIFY( file.open(QIODevice::ReadOnly) );
+    const BuiltinLanguage* language = findBuiltinLanguage( QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1).toHex() );
+    QVERIFY2( language != 0, "the native matchers were not generated from this language file" );
+
+    //the samples, with some characters the samples do not contain
+    QString text = QString::fromUtf8("\\\"\\n'\t\x0B \xC3\xA9\xF0\x9F\x98\x80 {- -} <!-- --> &#x20; 0x1F\n");
+    QDir samplesDir(samplesDirPath);
+    foreach (const QFileInfo& sampleFile, samplesDir.entryInfoList(QDir::Files, QDir::Name)) {
+        if ( sampleFile.suffix() == "styles" ) continue;
+        QFile sample( sampleFile.filePath() );
+        QVERIFY( sample.open(QIODevice::ReadOnly) );
+        text += QString::fromUtf8( sample.readAll() );
+    }
+
+    for (int i = 0; i < language->matcherCount; i++) {
+        const BuiltinMatcher& matcher = language->matchers[i];
+        QRegularExpression expression( QString::fromUtf8(matcher.pattern) );
+        QVERIFY( expression.isValid() );
+
+        for (int start = 0, textLength = text.length(); start < textLength; start++) {
+            for (int length = 1; length <= 12 && start + length <= textLength; length++) {
+                QString subject = text.mid(start, length);
+                if ( subject.at(0).isLowSurrogate() || subject.at(length - 1).isHighSurrogate() ) continue;    //the lexer never splits a character
+
+                for (int partial = 0; partial < 2; partial++) {
+                    QRegularExpressionMatch match = expression.match(subject, 0, partial ? QRegularExpression::PartialPreferFirstMatch : QRegularExpression::NormalMatch);
+                    int expected = match.hasMatch() ? match.capturedLength() : ( match.hasPartialMatch() ? NativePartialMatch : NativeNoMatch );
+                    int result = matcher.match(subject.constData(), subject.length(), partial);
+                    if (result != expected) {
+                        QFAIL( qPrintable( QString("%1 gives %2 instead of %3 for \"%4\"%5").arg( QString::fromUtf8(matcher.pattern) ).arg(result).arg(expected)
+                            .arg(subject).arg(partial ? " (partial matches allowed)" : "") ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+
+QTEST_MAIN(TestLeptonLexer)
+#include "tst_leptonlexer.moc"
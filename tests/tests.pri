@@ -0,0 +1,21 @@
+# settings shared by all the unit tests (see tests.pro)
+QT       += core gui xml widgets testlib
+
+TEMPLATE = app
+
+CONFIG      += c++14 console testcase debug
+CONFIG      -= app_bundle
+DEFINES     += "CXX11_REGEX"
+
+# the tests run from the source tree so that the bundled config files (languages, styles, etc.) are found
+DEFINES     += LEPTON_SOURCE_DIR=\\\"$$PWD/..\\\"
+
+CONFIG      += qscintilla2
+
+INCLUDEPATH += $$PWD/../src
+DEPENDPATH  += $$PWD/../src
+
+unix|win32: LIBS += -lqscintilla2
+
+# native matchers of the bundled language files, used by the lexer
+include($$PWD/../src/builtinlanguages.pri)
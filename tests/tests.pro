@@ -0,0 +1,6 @@
+# unit tests of Lepton Editor (build them with qmake and run them with `make check`; set
+# `QT_QPA_PLATFORM=offscreen` to run them without a display)
+TEMPLATE = subdirs
+
+SUBDIRS += lexer \
+    editjournal
@@ -0,0 +1,826 @@
+#!/usr/bin/env python3
+#
+# Project: Lepton Editor
+# File: genlexers.py
+# Author: Leonardo Banderali
+# Created: October 18, 2026
+#
+# Description:
+#     Lepton Editor is a text editor oriented towards programmers.  It's intended to be a
+#     flexible and extensible code editor which developers can easily customize to their
+#     liking.
+#
+#     This script is run at build time (see builtinlanguages.pri) to turn the regular
+#     expressions of the language files bundled with Lepton into native matchers: each
+#     expression becomes a deterministic state machine, stored in static C++ tables.  At run
+#     time, `GrammarRegistry` gives the token rules of a language file these matchers
+#     whenever the file on disk is identical (same SHA-1 hash) to the one Lepton was built
+#     with.  User-modified and custom language files only use `QRegularExpression`.
+#
+#     A native matcher must give exactly the result `QRegularExpression` (PCRE2) would give
+#     for a match anchored at the start of the text, with or without
+#     `PartialPreferFirstMatch` (PCRE2's hard partial matching).  The state machines are
+#     therefore built to follow PCRE2's backtracking order rather than to find the longest
+#     match: the states of the pattern's NFA are kept in priority order, as in a Pike VM, and
+#     the first thread to reach the end of the pattern wins over all the threads that have a
+#     lower priority.  Only the subset of PCRE2 used by language files is supported (literals,
+#     classes, groups, alternatives, greedy quantifiers, `^`, `\b`, `\B` and one character
+#     look-behinds); expressions using anything else are left to `QRegularExpression`.
+#
+# Copyright (C) 2026 Leonardo Banderali
+#
+# Usage Agreement:
+#     This file is part of Lepton Editor
+#
+#     Lepton Editor is free software: you can redistribute it and/or modify
+#     it under the terms of the GNU General Public License as published by
+#     the Free Software Foundation, either version 3 of the License, or
+#     any later version.
+#
+#     Lepton Editor is distributed in the hope that it will be useful,
+#     but WITHOUT ANY WARRANTY; without even the implied warranty of
+#     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#     GNU General Public License for more details.
+#
+#     You should have received a copy of the GNU General Public License
+#     along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Usage:
+#     genlexers.py -o <output .cpp file> <language file> [<language file> ...]
+
+import argparse
+import hashlib
+import os
+import sys
+import xml.etree.ElementTree as ElementTree
+
+
+
+#~helper functions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+def to_int(value):
+    # -converts an attribute value to an int the same way `QString::toInt()` does (0 on failure)
+    try:
+        return int(value.strip())
+    except (AttributeError, ValueError):
+        return 0
+
+def node_text(element):
+    # -returns the value of the first child of `element` if it is a text node, like
+    #  `QDomNode::firstChild().nodeValue()` (whitespace-only text nodes are dropped by QDom)
+    if element is None or element.text is None or element.text.strip() == "":
+        return ""
+    return element.text
+
+def last_child(element, tag):
+    # -returns the last child element of `element` named `tag` or `None`
+    children = [c for c in element if c.tag == tag]
+    return children[-1] if children else None
+
+def c_string(value):
+    # -returns `value` as a C string literal (in UTF-8), escaping everything that is not plain ASCII
+    out = []
+    for byte in value.encode("utf-8"):
+        c = chr(byte)
+        if c == "\\" or c == "\"" or c == "?":
+            out.append("\\" + c)
+        elif 32 <= byte < 127:
+            out.append(c)
+        else:
+            out.append("\\%03o" % byte)
+    return "\"" + "".join(out) + "\""
+
+def c_comment(value):
+    # -returns `value` in a form that can be put in a C++ line comment
+    return "".join(c if 32 <= ord(c) < 127 else "\\u%04x" % ord(c) for c in value)
+
+
+
+#~pattern extraction~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+def extract_patterns_from(element, patterns):
+    # -adds the patterns of the `rule` and `spanrule` elements in `element` to `patterns`
+    #  (mirrors `GrammarRegistry::extractRulesFrom()`)
+    for child in element:
+        if child.tag != "rule" and child.tag != "spanrule":
+            continue
+        rule_class = to_int(child.get("class"))
+        if rule_class < 0 or rule_class > 31:
+            continue
+        if child.tag == "rule":
+            patterns.append("^(" + node_text(child) + ")")
+        else:
+            patterns.append("^(" + node_text(last_child(child, "open")) + ")")
+            patterns.append("^(" + node_text(last_child(child, "close")) + ")")
+            extract_patterns_from(child, patterns)
+
+def extract_patterns(path):
+    # -returns the patterns of the token rules defined by a language file, without those of the
+    #  languages it uses or includes (mirrors `GrammarRegistry::compile()`)
+    root = ElementTree.parse(path).getroot()
+    tokenization = last_child(root, "tokenization")
+    if root.tag != "language" or tokenization is None:
+        return []
+
+    patterns = []
+
+    # keywords are looked up in the whole tokenization tree
+    for keywords in tokenization.iter("keywords"):
+        rule_class = to_int(keywords.get("class"))
+        if rule_class < 0 or rule_class > 31:
+            continue
+        patterns.append("^\\b(" + "|".join(node_text(keywords).split()) + ")\\b")
+
+    numbers = last_child(tokenization, "numbers")
+    if numbers is not None and 0 <= to_int(numbers.get("class")) <= 31:
+        patterns.append("^(\\b\\d+\\b)")
+
+    extract_patterns_from(tokenization, patterns)
+
+    # a pattern used by several rules only needs one matcher
+    unique = []
+    for pattern in patterns:
+        if pattern not in unique:
+            unique.append(pattern)
+    return unique
+
+
+
+#~regular expressions~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+class Unsupported(Exception):
+    # -raised for expressions (or parts of expressions) native matchers do not support
+    pass
+
+MAX_CODE_POINT = 0x10ffff
+
+def char_set(*ranges):
+    # -returns a set of characters, as a sorted list of disjoint (first, last) code point ranges
+    result = []
+    for first, last in sorted(ranges):
+        if result and first <= result[-1][1] + 1:
+            result[-1] = (result[-1][0], max(result[-1][1], last))
+        else:
+            result.append((first, last))
+    return result
+
+def union(a, b):
+    # -returns the union of two sets of characters
+    return char_set(*(a + b))
+
+def complement(a):
+    # -returns the set of all characters not in `a`
+    result = []
+    next_first = 0
+    for first, last in a:
+        if first > next_first:
+            result.append((next_first, first - 1))
+        next_first = last + 1
+    if next_first <= MAX_CODE_POINT:
+        result.append((next_first, MAX_CODE_POINT))
+    return result
+
+def contains(a, code_point):
+    # -returns true if `code_point` is in the set of characters `a`
+    for first, last in a:
+        if first <= code_point <= last:
+            return True
+    return False
+
+# without PCRE2_UCP, the character types of PCRE2 only contain ASCII characters
+DIGITS = char_set((0x30, 0x39))
+WORD_CHARS = char_set((0x30, 0x39), (0x41, 0x5a), (0x5f, 0x5f), (0x61, 0x7a))
+SPACES = char_set((0x09, 0x0d), (0x20, 0x20))
+ANY_BUT_NEWLINE = complement(char_set((0x0a, 0x0a)))
+
+CHARACTER_TYPES = {"d": DIGITS, "D": complement(DIGITS), "w": WORD_CHARS, "W": complement(WORD_CHARS),
+                   "s": SPACES, "S": complement(SPACES)}
+CHARACTER_ESCAPES = {"n": 0x0a, "t": 0x09, "r": 0x0d, "f": 0x0c, "e": 0x1b, "a": 0x07}
+
+# Expressions are parsed into trees of tuples:
+#   ("set", characters)                 one character from a set
+#   ("sequence", [nodes])               all nodes, one after the other
+#   ("alternatives", [nodes])           the first node that leads to a match
+#   ("repeat", node, minimum, maximum)  greedy repetition (`maximum` is `None` if there is no limit)
+#   ("assert", kind, characters)        `start` (^), `boundary` (\b), `not boundary` (\B) or
+#                                       `behind` / `not behind` (one character look-behind)
+
+class Parser:
+    # -a recursive descent parser for the PCRE2 syntax used by language files
+
+    def __init__(self, pattern):
+        self.pattern = pattern
+        self.position = 0
+
+    def peek(self, offset=0):
+        if self.position + offset < len(self.pattern):
+            return self.pattern[self.position + offset]
+        return None
+
+    def take(self):
+        c = self.peek()
+        if c is None:
+            raise Unsupported("unexpected end of pattern")
+        self.position += 1
+        return c
+
+    def parse(self):
+        node = self.alternatives()
+        if self.peek() is not None:
+            raise Unsupported("unbalanced parenthesis")
+        return node
+
+    def alternatives(self):
+        branches = [self.sequence()]
+        while self.peek() == "|":
+            self.take()
+            branches.append(self.sequence())
+        return branches[0] if len(branches) == 1 else ("alternatives", branches)
+
+    def sequence(self):
+        nodes = []
+        while self.peek() is not None and self.peek() != "|" and self.peek() != ")":
+            nodes.append(self.quantified(self.atom()))
+        return nodes[0] if len(nodes) == 1 else ("sequence", nodes)
+
+    def number(self):
+        digits = ""
+        while self.peek() is not None and self.peek() in "0123456789":
+            digits += self.take()
+        return int(digits) if digits else None
+
+    def quantified(self, node):
+        c = self.peek()
+        if c == "*":
+            minimum, maximum = 0, None
+        elif c == "+":
+            minimum, maximum = 1, None
+        elif c == "?":
+            minimum, maximum = 0, 1
+        elif c == "{":
+            # `{` only starts a quantifier if one follows, otherwise it is a literal character
+            start = self.position
+            self.take()
+            minimum = self.number()
+            maximum = minimum
+            if minimum is not None and self.peek() == ",":
+                self.take()
+                maximum = self.number()
+            if minimum is None or self.peek() != "}" or (maximum is not None and maximum < minimum):
+                self.position = start
+                return node
+        else:
+            return node
+        self.take()
+
+        if self.peek() == "?" or self.peek() == "+":
+            raise Unsupported("lazy or possessive quantifier")
+        if node[0] == "assert":
+            raise Unsupported("quantified assertion")
+        if maximum is None and nullable(node):
+            raise Unsupported("repetition of an expression that can match nothing")
+        if max(minimum, maximum or 0) > 100:
+            raise Unsupported("large repetition count")
+        return ("repeat", node, minimum, maximum)
+
+    def atom(self):
+        c = self.take()
+        if c == "(":
+            if self.peek() == "?":
+                self.take()
+                kind = self.take()
+                if kind == ":":
+                    node = self.alternatives()
+                elif kind == "<" and self.peek() in ("!", "="):
+                    negative = self.take() == "!"
+                    inner = self.alternatives()
+                    if inner[0] != "set":
+                        raise Unsupported("look-behind longer than one character")
+                    node = ("assert", "not behind" if negative else "behind", inner[1])
+                else:
+                    raise Unsupported("group type")
+            elif self.peek() == "*":
+                raise Unsupported("backtracking control verb")
+            else:
+                node = self.alternatives()
+            if self.take() != ")":
+                raise Unsupported("unbalanced parenthesis")
+            return node
+        if c == "[":
+            return ("set", self.char_class())
+        if c == ".":
+            return ("set", ANY_BUT_NEWLINE)
+        if c == "^":
+            return ("assert", "start", None)
+        if c == "$":
+            raise Unsupported("end of line assertion")
+        if c == "\\":
+            e = self.take()
+            if e in CHARACTER_TYPES:
+                return ("set", CHARACTER_TYPES[e])
+            if e == "b":
+                return ("assert", "boundary", None)
+            if e == "B":
+                return ("assert", "not boundary", None)
+            return ("set", char_set((self.escaped_char(e),) * 2))
+        if c == ")":
+            raise Unsupported("unbalanced parenthesis")
+        return ("set", char_set((ord(c), ord(c))))
+
+    def escaped_char(self, e):
+        # -returns the code point of the character escaped by `\e` (the backslash was already read)
+        if e in CHARACTER_ESCAPES:
+            return CHARACTER_ESCAPES[e]
+        if e == "x":
+            digits = ""
+            if self.peek() == "{":
+                self.take()
+                while self.peek() != "}":
+                    digits += self.take()
+                self.take()
+            else:
+                while len(digits) < 2 and self.peek() is not None and self.peek() in "0123456789abcdefABCDEF":
+                    digits += self.take()
+            try:
+                code_point = int(digits, 16) if digits else 0
+            except ValueError:
+                raise Unsupported("hexadecimal escape")
+            if code_point > MAX_CODE_POINT or 0xd800 <= code_point <= 0xdfff:
+                raise Unsupported("hexadecimal escape")
+            return code_point
+        if e.isalnum() or ord(e) > 127:
+            raise Unsupported("escape sequence \\" + e)
+        return ord(e)
+
+    def char_class(self):
+        # -returns the set of characters of a class (the `[` was already read)
+        negated = self.peek() == "^"
+        if negated:
+            self.take()
+
+        result = []
+        first_item = True
+        while True:
+            c = self.take()
+            if c == "]" and not first_item:
+                break
+            first_item = False
+
+            if c == "[" and self.peek() in (":", ".", "="):
+                raise Unsupported("POSIX class")
+            if c == "\\":
+                e = self.take()
+                if e in CHARACTER_TYPES:
+                    result = union(result, CHARACTER_TYPES[e])
+                    continue
+                low = 0x08 if e == "b" else self.escaped_char(e)
+            else:
+                low = ord(c)
+
+            if self.peek() == "-" and self.peek(1) is not None and self.peek(1) != "]":
+                self.take()
+                c = self.take()
+                if c == "[" and self.peek() in (":", ".", "="):
+                    raise Unsupported("POSIX class")
+                if c == "\\":
+                    e = self.take()
+                    if e in CHARACTER_TYPES:
+                        raise Unsupported("range ending with a character type")
+                    high = 0x08 if e == "b" else self.escaped_char(e)
+                else:
+                    high = ord(c)
+                if high < low:
+                    raise Unsupported("invalid range")
+                result = union(result, char_set((low, high)))
+            else:
+                result = union(result, char_set((low, low)))
+
+        return complement(result) if negated else result
+
+def nullable(node):
+    # -returns true if `node` can match an empty string
+    kind = node[0]
+    if kind == "set":
+        return False
+    if kind == "sequence":
+        return all(nullable(n) for n in node[1])
+    if kind == "alternatives":
+        return any(nullable(n) for n in node[1])
+    if kind == "repeat":
+        return node[2] == 0 or nullable(node[1])
+    return True
+
+
+
+#~state machines~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+MAX_STATES = 32000  # transitions are stored in 15 bits
+
+class NFA:
+    # -a non-deterministic automaton whose epsilon transitions are ordered by priority
+    #  (nodes are ["char", set, next], ["split", [next, ...]], ["assert", kind, set, next] or ["match"])
+
+    def __init__(self, tree):
+        self.nodes = []
+        self.start = self.build(tree, self.add(["match"]))
+
+    def add(self, node):
+        self.nodes.append(node)
+        return len(self.nodes) - 1
+
+    def build(self, tree, next_node):
+        # -adds the nodes matching `tree`, followed by `next_node`, and returns the first one
+        kind = tree[0]
+        if kind == "set":
+            return self.add(["char", tree[1], next_node])
+        if kind == "assert":
+            return self.add(["assert", tree[1], tree[2], next_node])
+        if kind == "sequence":
+            for node in reversed(tree[1]):
+                next_node = self.build(node, next_node)
+            return next_node
+        if kind == "alternatives":
+            return self.add(["split", [self.build(node, next_node) for node in tree[1]]])
+
+        # repetitions are greedy: one more repetition is always tried before what follows
+        node, minimum, maximum = tree[1], tree[2], tree[3]
+        if maximum is None:
+            loop = self.add(["split", None])
+            self.nodes[loop][1] = [self.build(node, loop), next_node]
+            next_node = loop
+        else:
+            for i in range(maximum - minimum):
+                next_node = self.add(["split", [self.build(node, next_node), next_node]])
+        for i in range(minimum):
+            next_node = self.build(node, next_node)
+        return next_node
+
+class StateMachine:
+    # -the deterministic state machine matching a pattern, with its character classes
+
+    def __init__(self, pattern):
+        self.pattern = pattern
+        self.nfa = NFA(Parser(pattern).parse())
+        nodes = self.nfa.nodes
+
+        self.uses_boundaries = any(n[0] == "assert" and n[1] in ("boundary", "not boundary") for n in nodes)
+        self.behind_sets = [n[2] for n in nodes if n[0] == "assert" and n[1] in ("behind", "not behind")]
+        self.build_classes([n[1] for n in nodes if n[0] == "char"])
+        self.build_states()
+        self.minimize()
+
+    def build_classes(self, sets):
+        # -splits the characters in classes of characters which no part of the pattern tells apart
+        sets = sets + self.behind_sets + ([WORD_CHARS] if self.uses_boundaries else [])
+        bounds = set([0, 0x80, MAX_CODE_POINT + 1])
+        for s in sets:
+            for first, last in s:
+                bounds.add(first)
+                bounds.add(last + 1)
+        bounds = sorted(bounds)
+
+        signatures = {}
+        self.representatives = []   # a character of every class
+        self.ranges = []            # (first code point, class) for every range of characters
+        for first, end in zip(bounds, bounds[1:]):
+            signature = tuple(contains(s, first) for s in sets)
+            if signature not in signatures:
+                signatures[signature] = len(self.representatives)
+                self.representatives.append(first)
+            if not self.ranges or self.ranges[-1][1] != signatures[signature] or first == 0x80:
+                self.ranges.append((first, signatures[signature]))
+        if len(self.representatives) > 255:
+            raise Unsupported("too many character classes")
+
+    def previous_info(self, code_point):
+        # -returns what assertions need to know about the character before a position
+        return (contains(WORD_CHARS, code_point) if self.uses_boundaries else None,
+                tuple(contains(s, code_point) for s in self.behind_sets))
+
+    def closure(self, kernel, previous, next_char, mode):
+        # -follows the epsilon transitions from the nodes in `kernel`, in priority order, at a
+        #  position preceded by a character described by `previous` (`None` at the start) and
+        #  followed by `next_char` (`None` at the end of the text)
+        #  returns the nodes reached, as ("char", node), ("match",) and ("partial",) items; nothing
+        #  reached after a match (or, at the end in `partial` mode, after a partial match) matters
+        nodes = self.nfa.nodes
+        items = []
+        visited = set()
+
+        def visit(index):
+            if index in visited:
+                return False
+            visited.add(index)
+            node = nodes[index]
+            if node[0] == "char":
+                items.append(("char", index))
+                return False
+            if node[0] == "match":
+                items.append(("match",))
+                return True
+            if node[0] == "split":
+                for next_node in node[1]:
+                    if visit(next_node):
+                        return True
+                return False
+
+            kind = node[1]
+            if kind == "start":
+                satisfied = previous is None
+            elif kind in ("behind", "not behind"):
+                found = previous is not None and previous[1][self.behind_sets.index(node[2])]
+                satisfied = found if kind == "behind" else not found
+            else:
+                # in hard partial mode, PCRE2 reports a partial match when `\b` or `\B` needs the next character
+                if next_char is None and mode == "partial":
+                    items.append(("partial",))
+                    return True
+                after_word = previous is not None and previous[0]
+                before_word = next_char is not None and contains(WORD_CHARS, next_char)
+                satisfied = (after_word != before_word) == (kind == "boundary")
+            return visit(node[3]) if satisfied else False
+
+        for index in kernel:
+            if visit(index):
+                break
+        return items
+
+    def build_states(self):
+        # -builds the states of the machine; a state is the list of NFA nodes threads are at (in priority
+        #  order) with what assertions need to know about the previous character
+        nodes = self.nfa.nodes
+        initial = ((self.nfa.start,), None)
+        index = {initial: 0}
+        pending = [initial]
+        self.transitions = []   # for every state and class: (next state or -1, true if there is a match before the character)
+        self.ends = []          # for every state: (match at the end, result at the end with partial matches allowed)
+
+        while pending:
+            kernel, previous = pending.pop(0)
+            row = []
+            for c in self.representatives:
+                items = self.closure(kernel, previous, c, "normal")
+                matched = bool(items) and items[-1][0] == "match"
+                next_kernel = []
+                for item in items:
+                    if item[0] == "char" and contains(nodes[item[1]][1], c) and nodes[item[1]][2] not in next_kernel:
+                        next_kernel.append(nodes[item[1]][2])
+                if not next_kernel:
+                    row.append((-1, matched))
+                    continue
+                state = (tuple(next_kernel), self.previous_info(c))
+                if state not in index:
+                    if len(index) >= MAX_STATES:
+                        raise Unsupported("too many states")
+                    index[state] = len(index)
+                    pending.append(state)
+                row.append((index[state], matched))
+            self.transitions.append(row)
+
+            normal = self.closure(kernel, previous, None, "normal")
+            partial = self.closure(kernel, previous, None, "partial")
+            first = partial[0][0] if partial else None
+            self.ends.append((bool(normal) and normal[-1][0] == "match",
+                              "match" if first == "match" else ("partial" if first is not None else "none")))
+
+    def minimize(self):
+        # -merges the states that behave the same way (Moore's algorithm)
+        blocks = {}
+        block_of = [blocks.setdefault(end, len(blocks)) for end in self.ends]
+        while True:
+            signatures = {}
+            new_block_of = []
+            for state, row in enumerate(self.transitions):
+                signature = (block_of[state],) + tuple((block_of[t] if t >= 0 else -1, m) for t, m in row)
+                new_block_of.append(signatures.setdefault(signature, len(signatures)))
+            if len(signatures) == len(set(block_of)):
+                break
+            block_of = new_block_of
+        block_of = new_block_of
+
+        # keep the initial state first
+        order = {}
+        for state in range(len(self.transitions)):
+            order.setdefault(block_of[state], len(order))
+        transitions = [None] * len(order)
+        ends = [None] * len(order)
+        for state, row in enumerate(self.transitions):
+            new_state = order[block_of[state]]
+            transitions[new_state] = [(order[block_of[t]] if t >= 0 else -1, m) for t, m in row]
+            ends[new_state] = self.ends[state]
+        self.transitions = transitions
+        self.ends = ends
+
+
+
+#~code generation~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+RUNTIME = """\
+/*
+The tables of a state machine.  Transitions are stored as `next state + 1` (0 when no thread is left),
+with `MatchedBefore` set if the pattern matched the text before the character.
+*/
+struct StateMachine {
+    const unsigned char* asciiClasses;  // class of every ASCII character
+    const unsigned int* rangeStarts;    // first code point of every range of non-ASCII characters
+    const unsigned char* rangeClasses;  // class of every range of non-ASCII characters
+    int rangeCount;                     // number of ranges of non-ASCII characters
+    int classCount;                     // number of character classes
+    const unsigned short* transitions;  // next state for every state and character class
+    const unsigned char* ends;          // what happens at the end of the text, for every state
+};
+
+enum {
+    MatchedBefore = 0x8000,
+    EndMatch = 1,           // the pattern matches the whole text
+    EndPartialMatch = 2,    // with partial matches allowed, the pattern matches the whole text
+    EndPartial = 4          // with partial matches allowed, the pattern partially matches the text
+};
+
+static int run(const StateMachine& machine, const QChar* text, int length, bool partial) {
+/*  -runs `machine` over `text` (see `NativeMatcher`) */
+    int matchLength = NativeNoMatch;
+    int state = 0;
+
+    for (int i = 0; i < length; ) {
+        uint c = text[i].unicode();
+        int size = 1;
+        if ( QChar::isHighSurrogate(c) && i + 1 < length && text[i + 1].isLowSurrogate() ) {
+            c = QChar::surrogateToUcs4( text[i], text[i + 1] );
+            size = 2;
+        }
+
+        int characterClass;
+        if (c < 0x80) {
+            characterClass = machine.asciiClasses[c];
+        }
+        else {
+            int range = 0;
+            while (range + 1 < machine.rangeCount && machine.rangeStarts[range + 1] <= c) range++;
+            characterClass = machine.rangeClasses[range];
+        }
+
+        unsigned short transition = machine.transitions[state * machine.classCount + characterClass];
+        if (transition & MatchedBefore) matchLength = i;
+        state = (transition & ~MatchedBefore) - 1;
+        if (state < 0) return matchLength;
+        i += size;
+    }
+
+    unsigned char end = machine.ends[state];
+    if (partial) {
+        if (end & EndPartial) return NativePartialMatch;
+        if (end & EndPartialMatch) return length;
+    }
+    else if (end & EndMatch) {
+        return length;
+    }
+    return matchLength;
+}
+"""
+
+def format_numbers(numbers, indent="    ", width=100):
+    # -returns `numbers` as the lines of the body of a C++ array
+    lines = []
+    line = indent
+    for n in numbers:
+        item = "%d," % n
+        if len(line) + len(item) + 1 > width and line.strip():
+            lines.append(line.rstrip())
+            line = indent
+        line += item + " "
+    if line.strip():
+        lines.append(line.rstrip())
+    return lines
+
+def generate_machine(out, symbol, machine):
+    # -appends the tables and the matcher function of `machine` to `out`
+    ascii_classes = [[cls for first, cls in machine.ranges if first <= c][-1] for c in range(0x80)]
+    ranges = [(first, cls) for first, cls in machine.ranges if first >= 0x80]
+
+    transitions = []
+    for row in machine.transitions:
+        for state, matched in row:
+            transitions.append((state + 1) | (0x8000 if matched else 0))
+    ends = []
+    for match, partial in machine.ends:
+        ends.append((1 if match else 0) | {"none": 0, "match": 2, "partial": 4}[partial])
+
+    out.append("// %s" % c_comment(machine.pattern))
+    out.append("static const unsigned char %s_asciiClasses[] = {" % symbol)
+    out.extend(format_numbers(ascii_classes))
+    out.append("};")
+    out.append("static const unsigned int %s_rangeStarts[] = { %s };" % (symbol, ", ".join("0x%x" % r[0] for r in ranges)))
+    out.append("static const unsigned char %s_rangeClasses[] = { %s };" % (symbol, ", ".join("%d" % r[1] for r in ranges)))
+    out.append("static const unsigned short %s_transitions[] = {" % symbol)
+    out.extend(format_numbers(transitions))
+    out.append("};")
+    out.append("static const unsigned char %s_ends[] = {" % symbol)
+    out.extend(format_numbers(ends))
+    out.append("};")
+    out.append("static const StateMachine %s_machine = { %s_asciiClasses, %s_rangeStarts, %s_rangeClasses, %d, %d, %s_transitions, %s_ends };" % (
+        symbol, symbol, symbol, symbol, len(ranges), len(machine.representatives), symbol, symbol))
+    out.append("static int %s(const QChar* text, int length, bool partial) {" % symbol)
+    out.append("    return run(%s_machine, text, length, partial);" % symbol)
+    out.append("}")
+    out.append("")
+
+def generate(paths):
+    # -returns the C++ source containing the native matchers of all language files in `paths`
+    out = []
+    out.append("/*")
+    out.append("This file was generated by tools/genlexers.py from the language files bundled with Lepton.")
+    out.append("Do not edit it, edit the language files instead.")
+    out.append("*/")
+    out.append("")
+    out.append("#include \"builtinlanguages.h\"")
+    out.append("")
+    out.append("#include <cstring>")
+    out.append("")
+    out.append(RUNTIME)
+
+    matchers = {}   # symbol of the matcher of every supported pattern
+    languages = []
+    for path in paths:
+        with open(path, "rb") as f:
+            digest = hashlib.sha1(f.read()).hexdigest()
+        try:
+            patterns = extract_patterns(path)
+        except ElementTree.ParseError:
+            sys.stderr.write("genlexers.py: skipping invalid language file %s\n" % path)
+            continue
+
+        entries = []
+        for pattern in patterns:
+            if pattern not in matchers:
+                try:
+                    machine = StateMachine(pattern)
+                except Unsupported as e:
+                    sys.stderr.write("genlexers.py: %s: no native matcher for %s (%s)\n" % (os.path.basename(path), pattern, e))
+                    matchers[pattern] = None
+                    continue
+                matchers[pattern] = "matcher_%d" % len(matchers)
+                generate_machine(out, matchers[pattern], machine)
+            if matchers[pattern] is not None:
+                entries.append((pattern, matchers[pattern]))
+
+        symbol = "language_%d" % len(languages)
+        out.append("// %s" % os.path.basename(path))
+        out.append("static const BuiltinMatcher %s_matchers[] = {" % symbol)
+        for pattern, matcher in entries:
+            out.append("    { %s, %s }," % (c_string(pattern), matcher))
+        if not entries:
+            out.append("    { 0, 0 }")
+        out.append("};")
+        out.append("")
+        languages.append((os.path.basename(path), digest, symbol, len(entries)))
+
+    out.append("static const BuiltinLanguage languages[] = {")
+    for file_name, digest, symbol, count in languages:
+        out.append("    { %s, %s, %s_matchers, %d }," % (c_string(file_name), c_string(digest), symbol, count))
+    if not languages:
+        out.append("    { 0, 0, 0, 0 }")
+    out.append("};")
+    out.append("")
+
+    # dispatch on the first character of the hash so at most a few hashes are compared
+    out.append("const BuiltinLanguage* findBuiltinLanguage(const QByteArray& sha1Hex) {")
+    out.append("    if (sha1Hex.size() != 40) return 0;")
+    out.append("")
+    out.append("    switch (sha1Hex.at(0)) {")
+    for digit in "0123456789abcdef":
+        matches = [i for i, language in enumerate(languages) if language[1][0] == digit]
+        if not matches:
+            continue
+        out.append("        case '%s':" % digit)
+        for i in matches:
+            out.append("            if (std::strcmp(languages[%d].sha1, sha1Hex.constData()) == 0) return &languages[%d];" % (i, i))
+        out.append("            break;")
+    out.append("        default:")
+    out.append("            break;")
+    out.append("    }")
+    out.append("    return 0;")
+    out.append("}")
+    out.append("")
+    return "\n".join(out)
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates the native matchers of Lepton's built-in languages.")
+    parser.add_argument("-o", "--output", required=True, help="the C++ source file to generate")
+    parser.add_argument("languages", nargs="+", help="the language files to build into Lepton")
+    args = parser.parse_args()
+
+    sys.setrecursionlimit(10000)
+    source = generate(args.languages)
+
+    # only touch the output if it changed, to avoid needless recompilation
+    if os.path.exists(args.output):
+        with open(args.output, "r") as f:
+            if f.read() == source:
+                return 0
+    with open(args.output, "w") as f:
+        f.write(source)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())